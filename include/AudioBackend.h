@@ -0,0 +1,231 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// A loaded sound or music. What the data holds depends on the backend that loaded it
+struct AudioData {
+   std::shared_ptr<void> data;
+   std::size_t bytes = 0;
+
+   explicit operator bool() const {
+      return data != nullptr;
+   }
+};
+
+enum class AudioBackendType
+{
+   MIXER,    // Plays through SDL_mixer
+   NONE,     // Plays nothing and only counts what was started
+   CAPTURE,  // Mixes every tick into a WAV file instead of playing it
+};
+
+/*
+ * An AudioBackend is what the SoundManager plays sounds and music with. The SoundManager decides
+ * which sound goes on which channel and when, and the backend only starts and stops them.
+ *
+ * The backends other than the mixer don't need an audio device, so a headless run can play the
+ * whole game without one. The capture backend also keeps time with the ticks instead of a clock,
+ * so two runs with the same input write the same WAV file and the same list of sounds.
+ * */
+
+class AudioBackend {
+  public:
+   virtual ~AudioBackend() = default;
+
+   // The capture backend writes to the path, the others don't use it
+   static std::unique_ptr<AudioBackend> create(AudioBackendType type,
+                                               const std::string& capturePath = "");
+
+   virtual const char* getName() const = 0;
+
+   // Returns the number of channels that sounds can be played on, or -1 if it couldn't be opened
+   virtual int open(int channelCount) = 0;
+   virtual void close() = 0;
+
+   // Loading is done on the SoundManager's background thread as well, so it has to be thread safe
+   virtual AudioData loadSound(const char* path) = 0;
+   virtual AudioData loadMusic(const char* path) = 0;
+
+   // The reason why the last load failed
+   virtual const char* getError() const = 0;
+
+   virtual bool playSound(int channel, const AudioData& sound) = 0;
+   virtual bool isPlaying(int channel) const = 0;
+   virtual void haltSound(int channel) = 0;
+   virtual void pauseSounds() = 0;
+   virtual void resumeSounds() = 0;
+
+   // Music loops until it is halted
+   virtual bool playMusic(const AudioData& music) = 0;
+   virtual void haltMusic() = 0;
+   virtual void pauseMusic() = 0;
+   virtual void resumeMusic() = 0;
+
+   // Called after the sounds of a tick were started
+   virtual void advanceTick() {}
+
+   // What the backend did, for the report of headless runs
+   virtual void printReport() {}
+};
+
+class MixerAudioBackend : public AudioBackend {
+  public:
+   const char* getName() const override {
+      return "mixer";
+   }
+
+   int open(int channelCount) override;
+   void close() override;
+
+   AudioData loadSound(const char* path) override;
+   AudioData loadMusic(const char* path) override;
+
+   const char* getError() const override;
+
+   bool playSound(int channel, const AudioData& sound) override;
+   bool isPlaying(int channel) const override;
+   void haltSound(int channel) override;
+   void pauseSounds() override;
+   void resumeSounds() override;
+
+   bool playMusic(const AudioData& music) override;
+   void haltMusic() override;
+   void pauseMusic() override;
+   void resumeMusic() override;
+};
+
+// Sounds end as soon as they start, so a channel is never busy and nothing is cut off
+class NullAudioBackend : public AudioBackend {
+  public:
+   const char* getName() const override {
+      return "null";
+   }
+
+   int open(int channelCount) override {
+      return channelCount;
+   }
+
+   void close() override {}
+
+   AudioData loadSound(const char* path) override;
+   AudioData loadMusic(const char* path) override;
+
+   const char* getError() const override {
+      return "The file doesn't exist";
+   }
+
+   bool playSound(int channel, const AudioData& sound) override;
+
+   bool isPlaying(int channel) const override {
+      return false;
+   }
+
+   void haltSound(int channel) override {}
+   void pauseSounds() override {}
+   void resumeSounds() override {}
+
+   bool playMusic(const AudioData& music) override;
+   void haltMusic() override {}
+   void pauseMusic() override {}
+   void resumeMusic() override {}
+
+   void advanceTick() override {
+      tick++;
+   }
+
+   void printReport() override;
+
+  private:
+   uint64_t tick = 0;
+
+   int soundCount = 0;
+   int musicCount = 0;
+};
+
+/*
+ * The capture backend decodes the sounds and music to 16 bit stereo samples and mixes one tick's
+ * worth of them into a WAV file on every tick. Every sound and music that starts is also written
+ * to a log next to the WAV file, with the tick that it started on:
+ *
+ *    120 sound 2 res/sounds/effects/jump.wav
+ *    300 music res/sounds/music/underground.wav
+ * */
+
+class CaptureAudioBackend : public AudioBackend {
+  public:
+   static constexpr int SAMPLE_RATE = 44100;
+   static constexpr int SPEAKERS = 2;
+
+   explicit CaptureAudioBackend(std::string path) : path{std::move(path)} {}
+
+   ~CaptureAudioBackend();
+
+   const char* getName() const override {
+      return "capture";
+   }
+
+   int open(int channelCount) override;
+   void close() override;
+
+   AudioData loadSound(const char* path) override;
+   AudioData loadMusic(const char* path) override;
+
+   const char* getError() const override;
+
+   bool playSound(int channel, const AudioData& sound) override;
+   bool isPlaying(int channel) const override;
+   void haltSound(int channel) override;
+   void pauseSounds() override;
+   void resumeSounds() override;
+
+   bool playMusic(const AudioData& music) override;
+   void haltMusic() override;
+   void pauseMusic() override;
+   void resumeMusic() override;
+
+   void advanceTick() override;
+
+   void printReport() override;
+
+  private:
+   struct Clip {
+      std::string path;
+      std::vector<int16_t> samples;  // The speakers' samples are interleaved
+   };
+
+   struct Voice {
+      std::shared_ptr<const Clip> clip;
+      std::size_t position = 0;
+      bool paused = false;
+   };
+
+   static AudioData loadClip(const char* path);
+
+   // Adds the voice's next samples to the mix, returns false once the clip has ended
+   static bool mixVoice(Voice& voice, std::vector<int32_t>& mix, bool loop);
+
+   void writeHeader();
+
+   std::string path;
+
+   std::ofstream file;
+   std::ofstream log;
+
+   std::vector<Voice> voices;
+   Voice music;
+
+   std::vector<int32_t> mix;
+   std::vector<char> frameBytes;
+
+   uint64_t tick = 0;
+   uint64_t sampleCount = 0;  // Per speaker
+
+   int soundCount = 0;
+   int musicCount = 0;
+   int clippedCount = 0;  // Samples that were too loud and were cut off
+};
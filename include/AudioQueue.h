@@ -0,0 +1,79 @@
+#pragma once
+
+#include "SoundManager.h"
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+
+enum class AudioEventType
+{
+   SOUND,
+   MUSIC
+};
+
+struct AudioEvent {
+   AudioEventType type;
+
+   union {
+      SoundID sound;
+      MusicID music;
+   };
+};
+
+/*
+ * The AudioQueue collects the sounds and music that were asked for during a tick, and the
+ * SoundSystem plays them when it ticks. It is a fixed ring buffer, so asking for a sound doesn't
+ * allocate anything, and a sound that is already waiting to be played isn't queued a second time,
+ * so the same sound from many entities on one tick is only played once.
+ *
+ * Only the simulation thread uses it.
+ * */
+
+class AudioQueue {
+  public:
+   static AudioQueue& Get() {
+      return instance;
+   }
+
+   void playSound(SoundID sound);
+
+   void playMusic(MusicID music);
+
+   // Takes the oldest event, returns false once the queue is empty
+   bool pop(AudioEvent& event);
+
+   // Forgets the events that weren't played, like the ones that the last scene left behind
+   void clear();
+
+   // The sounds that were left out because the same sound was already queued
+   int getMergedCount() const {
+      return mergedCount;
+   }
+
+   // The events that were lost because the queue was full
+   int getDroppedCount() const {
+      return droppedCount;
+   }
+
+  private:
+   AudioQueue() = default;
+
+   AudioQueue(const AudioQueue&) = delete;
+
+   static AudioQueue instance;
+
+   // A power of two, so the positions can wrap with a mask
+   static constexpr std::size_t CAPACITY = 64;
+
+   void push(const AudioEvent& event);
+
+   std::array<AudioEvent, CAPACITY> events;
+   std::size_t head = 0;
+   std::size_t tail = 0;
+
+   std::bitset<(std::size_t)SoundID::COUNT> queuedSounds;
+
+   int mergedCount = 0;
+   int droppedCount = 0;
+};
@@ -2,6 +2,19 @@
 
 #include "ECS/Components.h"
 
+// The left side of the camera moved from previousX to x
+struct CameraPassedXEvent {
+   static constexpr const char* NAME = "camera passed x";
+
+   float previousX;
+   float x;
+
+   // True if the left side of the camera went past the line on this move
+   bool passed(float line) const {
+      return (previousX < line && x >= line) || (previousX > line && x <= line);
+   }
+};
+
 class Camera {
   public:
    static Camera& Get() {
@@ -37,6 +50,9 @@ class Camera {
 
    Camera(const Camera&) = delete;
 
+   // Moves the left side of the camera and publishes a CameraPassedXEvent
+   void moveCameraX(float x);
+
    static Camera m_instance;
 
    float m_cameraX = 0.0, m_cameraY = 0.0;
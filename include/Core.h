@@ -1,15 +1,44 @@
 #pragma once
 
+#include "FrameCapture.h"
 #include "Game.h"
+#include "SoundManager.h"
+
+#include <atomic>
+#include <string>
+
+// Options that are set from the command line when the game is launched
+struct LaunchOptions {
+   bool headless = false;  // Renders offscreen with a software renderer and no window
+   int frameLimit = 0;     // The game quits after this many frames, 0 runs until it is closed
+   bool singleThreaded = false;  // Simulates and renders each frame in turn on the main thread
+   int seed = -1;          // Seed for the random number generator, -1 seeds it with the time
+   bool lowResolution = false;  // Draws the world at its original resolution and scales it up
+   bool streamEntities = false;  // Only creates the entities of the level near the camera
+   int soundChannels = DEFAULT_SOUND_CHANNELS;  // The number of sounds that can play at once
+   std::size_t musicBudget = DEFAULT_MUSIC_BUDGET;  // Bytes of music that are kept loaded
+   AudioBackendType audioBackend = AudioBackendType::MIXER;
+   std::string audioCapturePath;  // The WAV file that the capture backend writes
+
+   std::string inputRecordPath;    // Saves the input of every tick to this file
+   std::string inputPlaybackPath;  // Plays the input back from this file instead of the keyboard
+
+   CaptureFormat captureFormat = CaptureFormat::NONE;
+   std::string capturePath;
+   int captureInterval = 1;  // Every Nth frame is captured
+};
 
 class Core {
   public:
    Core();
 
+   void parseArguments(int argc, char** argv);
+
    int init();
 
    void run();
 
+   // Simulates and then renders one frame, used when the game runs on a single thread
    void mainLoop();
 
    void limitFPS(Uint64 startTick);
@@ -17,6 +46,16 @@ class Core {
    void setRunning(bool val);
 
   private:
+   // Simulates one frame, which publishes a RenderSnapshot for the render thread to draw
+   void tick();
+
+   // Simulates on a separate thread while the main thread polls events and draws snapshots
+   void runThreaded();
+
    Game game;
-   bool running;
+   LaunchOptions options;
+   std::atomic<bool> running;
+   bool threaded = false;
+
+   int frameCount = 0;
 };
@@ -2,13 +2,17 @@
 
 #include "Constants.h"
 #include "ECS.h"
+#include "LevelObjectTypes.h"
 #include "Map.h"
 #include "SMBMath.h"
 #include "SoundManager.h"
 #include "TextureManager.h"
+#include "TimerWheel.h"
+#include "util/InlineFunction.h"
 
 #include <SDL2/SDL.h>
 
+#include <algorithm>
 #include <cmath>
 #include <functional>
 #include <iostream>
@@ -84,12 +88,20 @@ struct PositionComponent : public Component {
 struct TextureComponent : public Component {
    TextureComponent(std::shared_ptr<SDL_Texture> texture, bool horizontalFlip = false,
                     bool verticalFlip = false)
-       : texture{texture}, horizontalFlipped{horizontalFlip}, verticalFlipped{verticalFlip} {};
+       : texture{texture},
+         atlasArea{TextureAtlas::getArea(texture)},
+         horizontalFlipped{horizontalFlip},
+         verticalFlipped{verticalFlip} {};
 
    std::shared_ptr<SDL_Texture> getTexture() {
       return texture;
    }
 
+   // Where the texture is on its atlas page, nullptr if it isn't in the atlas
+   const SDL_Rect* getAtlasArea() {
+      return atlasArea;
+   }
+
    SDL_Rect getSourceRect() {
       return sourceRect;
    }
@@ -122,6 +134,7 @@ struct TextureComponent : public Component {
    SDL_Rect sourceRect;
 
    std::shared_ptr<SDL_Texture> texture;
+   const SDL_Rect* atlasArea;
    bool horizontalFlipped = false;
    bool verticalFlipped = false;
    bool visible = true;
@@ -205,15 +218,9 @@ struct TextComponent : public Component {
                  bool visible = true)
        : text{text}, fontSize{fontSize}, followCamera{followCamera}, visible{visible} {}
 
-   ~TextComponent() {
-      if (texture != nullptr) {
-         SDL_DestroyTexture(texture);
-      }
-   }
-
-   void destroyTexture() {
-      SDL_DestroyTexture(texture);
-      texture = nullptr;
+   // Has to be called when the text changes, so the size of the text gets measured again
+   void invalidate() {
+      measured = false;
    }
 
    bool isVisible() {
@@ -228,25 +235,21 @@ struct TextComponent : public Component {
    unsigned int fontSize;
    bool followCamera;
    bool visible;
-   SDL_Texture* texture = nullptr;
+   bool measured = false;
 };
 
-/* SOUND COMPONENTS */
-struct SoundComponent : public Component {
-   SoundComponent(SoundID sound) : soundID{sound} {}
-   SoundID soundID;
-};
+/* ANIMATION COMPONENTS */
 
-struct MusicComponent : public Component {
-   MusicComponent(MusicID music) : musicID{music} {}
+// An animation that doesn't repeat played its last frame and was removed from the entity
+struct AnimationFinishedEvent {
+   static constexpr const char* NAME = "animation finished";
 
-   MusicID musicID;
+   Entity* entity;
 };
 
-/* ANIMATION COMPONENTS */
 struct AnimationComponent : public Component {
    AnimationComponent(std::vector<int> frameIDS, int framesPerSecond,
-                      std::unordered_map<int, Vector2i>& coordinateSupplier, bool repeated = true)
+                      const SpriteIDTable& coordinateSupplier, bool repeated = true)
        : frameIDS{frameIDS},
          frameCount{(int)frameIDS.size()},
          framesPerSecond{framesPerSecond},
@@ -271,7 +274,7 @@ struct AnimationComponent : public Component {
    int framesPerSecond;
    int frameDelay;
    int frameTimer = 0;
-   std::unordered_map<int, Vector2i>& coordinateSupplier;
+   const SpriteIDTable& coordinateSupplier;
    bool repeated;
    int currentFrame = 0;
 };
@@ -298,43 +301,82 @@ struct EndingBlinkComponent : public Component {
 };
 
 /* CALLBACK COMPONENTS */
-struct CallbackComponent : public Component {
+
+// The callback components are kept in TimerWheels that the CallbackSystem advances, so they are
+// only looked at on the tick that they expire on
+
+// Runs the callback once after the given number of ticks, and then removes itself
+struct CallbackComponent : public Component, public TimerWheel::Timer {
    CallbackComponent() = default;
-   CallbackComponent(std::function<void(Entity*)> callback, int time)
-       : callback{callback}, time{time} {}
+   CallbackComponent(InlineFunction<void(Entity*)> callback, int time)
+       : callback{std::move(callback)}, time{time} {}
 
-   std::function<void(Entity*)> callback;
-   int time;
+   void onAdded(Entity* entity) override {
+      owner = entity;
+
+      // A callback without any time left never ran
+      if (time > 0) {
+         timers.schedule(this, time);
+      }
+   }
+
+   inline static TimerWheel timers;
+
+   InlineFunction<void(Entity*)> callback;
+   int time = 0;
+
+   Entity* owner = nullptr;
 };
 
-struct DestroyDelayedComponent : public Component {
+// Destroys the entity once the given number of ticks have passed
+struct DestroyDelayedComponent : public Component, public TimerWheel::Timer {
    DestroyDelayedComponent(int time) : time{time} {}
 
+   void onAdded(Entity* entity) override {
+      owner = entity;
+      timers.schedule(this, std::max(time, 0) + 1);
+   }
+
+   inline static TimerWheel timers;
+
    int time;
+
+   Entity* owner = nullptr;
 };
 
-struct TimerComponent : public Component {
-   TimerComponent(std::function<void(Entity*)> onExecute, int delay)
-       : onExecute{onExecute}, delay{delay} {
-      time = delay;
+// Runs onExecute every time the delay has passed
+struct TimerComponent : public Component, public TimerWheel::Timer {
+   TimerComponent(InlineFunction<void(Entity*)> onExecute, int delay)
+       : onExecute{std::move(onExecute)}, delay{delay} {}
+
+   void onAdded(Entity* entity) override {
+      owner = entity;
+      reset();
    }
 
-   std::function<void(Entity*)> onExecute;
+   inline static TimerWheel timers;
+
+   InlineFunction<void(Entity*)> onExecute;
    int delay;
-   int time;
 
+   Entity* owner = nullptr;
+
+   // Starts counting down the delay again
    void reset() {
-      time = delay;
+      if (delay > 0) {
+         timers.schedule(this, delay);
+      }
    }
 };
 
 struct WaitUntilComponent : public Component {
    WaitUntilComponent() = default;
-   WaitUntilComponent(std::function<bool(Entity*)> condition, std::function<void(Entity*)> doAfter)
-       : condition{condition}, doAfter{doAfter} {}
+   WaitUntilComponent(InlineFunction<bool(Entity*)> condition,
+                      InlineFunction<void(Entity*)> doAfter)
+       : condition{std::move(condition)}, doAfter{std::move(doAfter)} {}
 
-   std::function<bool(Entity*)> condition;
-   std::function<void(Entity*)> doAfter;
+   InlineFunction<bool(Entity*)> condition;
+   InlineFunction<void(Entity*)> doAfter;
 };
 
 /* UNCATEGORiZED */
@@ -375,24 +417,6 @@ struct DestructibleComponent : public Component {
 
 struct BumpableComponent : public Component {};
 
-enum class Direction
-{
-   NONE,
-   UP,
-   DOWN,
-   LEFT,
-   RIGHT
-};
-
-enum class PlatformMotionType
-{
-   NONE,
-   ONE_DIRECTION_REPEATED,    // Moves in one direction, but goes to min point when it reaches max
-   ONE_DIRECTION_CONTINUOUS,  // Continuously moving in one direction
-   BACK_AND_FORTH,            // Moves back and forth
-   GRAVITY                    // Affected by Gravity when mario stands on it
-};
-
 enum class LevelType;
 
 struct WarpPipeComponent : public Component {
@@ -459,13 +483,6 @@ struct PlatformLevelComponent : public Component {
    int pulleyHeight;
 };
 
-enum class RotationDirection
-{
-   NONE,
-   CLOCKWISE,
-   COUNTER_CLOCKWISE,
-};
-
 struct FireBarComponent : public Component {
    FireBarComponent() = default;
    FireBarComponent(Vector2f rotationPoint, float barPosition, float startAngle,
@@ -560,16 +577,6 @@ struct AxeComponent : public Component {};
 
 struct ParticleComponent : public Component {};
 
-enum class MysteryBoxType
-{
-   NONE,
-   MUSHROOM,
-   COINS,
-   SUPER_STAR,
-   ONE_UP,
-   VINES
-};
-
 struct MysteryBoxComponent : public Component {
    MysteryBoxComponent() = default;
    MysteryBoxComponent(MysteryBoxType type = MysteryBoxType::NONE) : boxType{type} {}
@@ -628,13 +635,37 @@ enum class CollisionDirection
    RIGHT
 };
 
-struct TopCollisionComponent : public Component {};
+// A collision component was added to the entity
+struct CollisionStartedEvent {
+   static constexpr const char* NAME = "collision started";
+
+   Entity* entity;
+   CollisionDirection direction;
+};
+
+struct TopCollisionComponent : public Component {
+   void onAdded(Entity* entity) override {
+      EventBus::Get().publish(CollisionStartedEvent{entity, CollisionDirection::TOP});
+   }
+};
 
-struct BottomCollisionComponent : public Component {};
+struct BottomCollisionComponent : public Component {
+   void onAdded(Entity* entity) override {
+      EventBus::Get().publish(CollisionStartedEvent{entity, CollisionDirection::BOTTOM});
+   }
+};
 
-struct LeftCollisionComponent : public Component {};
+struct LeftCollisionComponent : public Component {
+   void onAdded(Entity* entity) override {
+      EventBus::Get().publish(CollisionStartedEvent{entity, CollisionDirection::LEFT});
+   }
+};
 
-struct RightCollisionComponent : public Component {};
+struct RightCollisionComponent : public Component {
+   void onAdded(Entity* entity) override {
+      EventBus::Get().publish(CollisionStartedEvent{entity, CollisionDirection::RIGHT});
+   }
+};
 
 /* PLAYER COMPONENTS */
 enum class PlayerState
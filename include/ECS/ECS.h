@@ -1,5 +1,7 @@
 #pragma once
 
+#include "EventBus.h"
+
 #include <SDL2/SDL.h>
 
 #include <algorithm>
@@ -55,6 +57,9 @@ using ComponentArray = std::array<Component*, maxComponents>;
 
 struct Component {
    virtual ~Component() = default;
+
+   // Called once the component was added to an entity
+   virtual void onAdded(Entity* entity) {}
 };
 
 class Entity {
@@ -76,6 +81,8 @@ class Entity {
       componentArray[getComponentTypeID<ComponentType>()] = ptr;
       componentBitset[getComponentTypeID<ComponentType>()] = true;
 
+      ptr->onAdded(this);
+
       return ptr;
    }
 
@@ -209,6 +216,7 @@ class World {
       systems.clear();
 
       for (auto entity : entities) {
+         EventBus::Get().entityDestroyed(entity);
          delete entity;
       }
       entities.clear();
@@ -216,10 +224,27 @@ class World {
 
    Entity* create() {
       auto* entity = new Entity();
-      entities.push_back(entity);
+
+      if (stagedEntities != nullptr) {
+         stagedEntities->push_back(entity);
+      } else {
+         entities.push_back(entity);
+      }
       return entity;
    }
 
+   // While a list is set, the entities that the calling thread creates go into it instead of the
+   // world. This lets a loader thread build entities without racing the systems that tick the
+   // world, which then get all of them at once from publish()
+   static void setStagingList(std::vector<Entity*>* list) {
+      stagedEntities = list;
+   }
+
+   void publish(std::vector<Entity*>& staged) {
+      entities.insert(entities.end(), staged.begin(), staged.end());
+      staged.clear();
+   }
+
    void destroy(Entity* entity) {
       assert(entity && "Destroying non-existent entity.");
 
@@ -234,6 +259,7 @@ class World {
                                        }),
                         entities.end());
 
+         EventBus::Get().entityDestroyed(entity);
          delete entity;
       }
 
@@ -374,6 +400,8 @@ class World {
    }
 
   private:
+   inline static thread_local std::vector<Entity*>* stagedEntities = nullptr;
+
    std::vector<Entity*> entities;
    std::vector<Entity*> destroyQueue;
 
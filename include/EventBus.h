@@ -0,0 +1,294 @@
+#pragma once
+
+#include "util/InlineFunction.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class Entity;
+
+// The entity is about to be deleted, so handlers may only compare the pointer. Other events are
+// declared next to the components that they are about
+struct EntityDestroyedEvent {
+   static constexpr const char* NAME = "entity destroyed";
+
+   Entity* entity;
+};
+
+/*
+ * The EventBus lets code wait for something to happen instead of checking for it on every tick.
+ * A handler is subscribed to one type of event and returns true once it is done, which
+ * unsubscribes it. A handler that is subscribed for an entity only gets the events about that
+ * entity, and it is dropped when the entity is destroyed.
+ *
+ * Published events are queued, and nothing is queued for an event that has no subscribers.
+ * dispatch() hands them out from the CallbackSystem, where WaitUntilComponents are checked, so
+ * handlers can add and remove components like the WaitUntilComponent callbacks do.
+ * EntityDestroyedEvents are the exception, they are handed out right away.
+ * */
+
+class EventBus {
+  public:
+   using SubscriptionID = std::uint32_t;
+
+   // Unsubscribes when it is destroyed, for waiters that can go away before their event comes
+   class Subscription {
+     public:
+      Subscription() = default;
+
+      explicit Subscription(SubscriptionID id) : id{id} {}
+
+      Subscription(Subscription&& other) noexcept : id{other.id} {
+         other.id = 0;
+      }
+
+      Subscription& operator=(Subscription&& other) noexcept {
+         if (this != &other) {
+            reset();
+            id = other.id;
+            other.id = 0;
+         }
+         return *this;
+      }
+
+      ~Subscription() {
+         reset();
+      }
+
+      void reset() {
+         if (id != 0) {
+            EventBus::Get().unsubscribe(id);
+            id = 0;
+         }
+      }
+
+      explicit operator bool() const {
+         return id != 0;
+      }
+
+     private:
+      SubscriptionID id = 0;
+   };
+
+   static EventBus& Get() {
+      return instance;
+   }
+
+   EventBus(const EventBus&) = delete;
+
+   // Subscribes to every event of the type
+   template <typename Event, typename Handler>
+   SubscriptionID subscribe(Handler&& handler) {
+      return subscribe<Event>(nullptr, std::forward<Handler>(handler));
+   }
+
+   // Subscribes to the events about the entity, until it is destroyed
+   template <typename Event, typename Handler>
+   SubscriptionID subscribe(Entity* entity, Handler&& handler) {
+      static_assert(std::is_invocable_r_v<bool, std::decay_t<Handler>&, const Event&>,
+                    "An event handler takes the event and returns true once it is done");
+
+      std::lock_guard<std::recursive_mutex> lock(mutex);
+
+      SubscriptionID id = nextID++;
+
+      getChannel<Event>().add(
+          Subscriber{id, entity,
+                     [handler = std::forward<Handler>(handler)](const void* event) mutable {
+                        return handler(*static_cast<const Event*>(event));
+                     }});
+
+      return id;
+   }
+
+   void unsubscribe(SubscriptionID id);
+
+   template <typename Event>
+   void publish(const Event& event) {
+      std::lock_guard<std::recursive_mutex> lock(mutex);
+
+      getChannel<Event>().queue(event);
+   }
+
+   // Hands the queued events to their handlers. Events that the handlers publish wait for the
+   // next dispatch
+   void dispatch();
+
+   // Publishes an EntityDestroyedEvent right away, then drops the subscriptions and queued events
+   // for the entity
+   void entityDestroyed(Entity* entity);
+
+   template <typename Event>
+   int getSubscriberCount() {
+      std::lock_guard<std::recursive_mutex> lock(mutex);
+
+      return getChannel<Event>().getSubscriberCount();
+   }
+
+   // The name and number of subscribers of every event type that was used
+   std::vector<std::pair<const char*, int>> getSubscriberCounts();
+
+  private:
+   EventBus() = default;
+
+   using Handler = InlineFunction<bool(const void*)>;
+
+   struct Subscriber {
+      SubscriptionID id;
+      Entity* entity;
+      Handler handler;
+   };
+
+   class Channel {
+     public:
+      virtual ~Channel() = default;
+
+      virtual const char* getName() const = 0;
+
+      virtual void deliverQueued() = 0;
+
+      // Drops the queued events about the entity
+      virtual void forgetQueued(Entity* entity) = 0;
+
+      void add(Subscriber subscriber);
+
+      bool remove(SubscriptionID id);
+
+      void removeEntity(Entity* entity);
+
+      int getSubscriberCount() const {
+         return subscriberCount;
+      }
+
+     protected:
+      // True if anything would get an event about the entity
+      bool isWanted(Entity* entity) const {
+         return globalCount > 0 || (entity != nullptr && entityCounts.count(entity) > 0);
+      }
+
+      void deliver(const void* event, Entity* entity);
+
+     private:
+      void removeAt(std::size_t index);
+
+      void compact();
+
+      std::vector<Subscriber> subscribers;
+
+      // Subscribers that were added while delivering, so the handlers being called don't move
+      std::vector<Subscriber> added;
+
+      std::unordered_map<Entity*, int> entityCounts;
+      int globalCount = 0;
+      int subscriberCount = 0;
+
+      int deliverDepth = 0;
+      bool hasRemoved = false;
+   };
+
+   // Finds the entity member of an event, if it has one
+   template <typename Event, typename = void>
+   struct EventEntity {
+      static Entity* get(const Event&) {
+         return nullptr;
+      }
+   };
+
+   template <typename Event>
+   struct EventEntity<Event, std::void_t<decltype(std::declval<const Event&>().entity)>> {
+      static Entity* get(const Event& event) {
+         return event.entity;
+      }
+   };
+
+   template <typename Event>
+   class TypedChannel : public Channel {
+     public:
+      const char* getName() const override {
+         return Event::NAME;
+      }
+
+      void queue(const Event& event) {
+         if (isWanted(EventEntity<Event>::get(event))) {
+            queued.push_back(event);
+         }
+      }
+
+      void deliverNow(const Event& event) {
+         Entity* entity = EventEntity<Event>::get(event);
+
+         if (isWanted(entity)) {
+            deliver(&event, entity);
+         }
+      }
+
+      void deliverQueued() override {
+         if (queued.empty()) {
+            return;
+         }
+
+         // Swapped so that the handlers can queue new events, and both vectors keep their memory
+         delivering.swap(queued);
+
+         for (const Event& event : delivering) {
+            deliver(&event, EventEntity<Event>::get(event));
+         }
+
+         delivering.clear();
+      }
+
+      void forgetQueued(Entity* entity) override {
+         queued.erase(std::remove_if(queued.begin(), queued.end(),
+                                     [entity](const Event& event) {
+                                        return EventEntity<Event>::get(event) == entity;
+                                     }),
+                      queued.end());
+      }
+
+     private:
+      std::vector<Event> queued;
+      std::vector<Event> delivering;
+   };
+
+   static std::size_t getNewEventTypeID() {
+      static std::size_t lastID = 0;
+      return lastID++;
+   }
+
+   template <typename Event>
+   static std::size_t getEventTypeID() {
+      static std::size_t typeID = getNewEventTypeID();
+      return typeID;
+   }
+
+   template <typename Event>
+   TypedChannel<Event>& getChannel() {
+      std::size_t typeID = getEventTypeID<Event>();
+
+      if (typeID >= channels.size()) {
+         channels.resize(typeID + 1);
+      }
+      if (!channels[typeID]) {
+         channels[typeID] = std::make_unique<TypedChannel<Event>>();
+      }
+
+      return static_cast<TypedChannel<Event>&>(*channels[typeID]);
+   }
+
+   static EventBus instance;
+
+   // Recursive, since handlers run while it is held and may subscribe or publish. Entities that a
+   // loader thread builds can subscribe while the simulation thread dispatches
+   std::recursive_mutex mutex;
+
+   std::vector<std::unique_ptr<Channel>> channels;
+
+   SubscriptionID nextID = 1;
+};
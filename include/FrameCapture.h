@@ -0,0 +1,84 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * The FrameCapture copies every Nth rendered frame out of the renderer and hands it to a writer
+ * thread, which saves it either as a numbered PNG or as raw RGBA bytes appended to a stream.
+ *
+ * Frames are numbered by how many frames have been displayed, not by time, so two runs with the
+ * same input produce the same file names. The queue between the game loop and the writer thread
+ * is bounded; if the writer falls behind, the game loop waits for a free slot instead of dropping
+ * frames.
+ * */
+
+enum class CaptureFormat
+{
+   NONE,
+   PNG,  // One PNG file per frame, written into a directory
+   RAW   // Raw RGBA frames written back to back into a file, or to stdout when the path is "-"
+};
+
+class FrameCapture {
+  public:
+   FrameCapture() = default;
+
+   ~FrameCapture();
+
+   int start(CaptureFormat format, const std::string& path, int interval, int width, int height);
+
+   void stop();
+
+   // Has to be called after the frame is drawn, but before it is presented
+   void captureFrame(SDL_Renderer* renderer);
+
+   bool isCapturing() {
+      return capturing;
+   }
+
+  private:
+   FrameCapture(const FrameCapture&) = delete;
+
+   struct Frame {
+      int frameNumber;
+      std::vector<Uint8> pixels;
+   };
+
+   static constexpr std::size_t MAX_QUEUED_FRAMES = 8;
+
+   void writeFrames();
+
+   void writeFrame(Frame& frame);
+
+   CaptureFormat format = CaptureFormat::NONE;
+   std::string path;
+
+   int interval = 1;
+   int width = 0;
+   int height = 0;
+
+   int frameCounter = 0;
+   int capturedFrames = 0;
+   int stalledFrames = 0;  // Frames where the game loop had to wait for the writer thread
+
+   bool capturing = false;
+   bool stopping = false;
+
+   FILE* rawStream = nullptr;
+   std::streambuf* coutBuffer = nullptr;  // Restored once a capture to stdout is finished
+
+   std::thread writerThread;
+   std::mutex queueMutex;
+   std::condition_variable queueChanged;
+   std::deque<Frame> frameQueue;
+   std::vector<std::vector<Uint8>> freeBuffers;  // Pixel buffers are reused between frames
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "InputRecording.h"
 #include "scenes/GameOverScene.h"
 #include "scenes/GameScene.h"
 #include "scenes/MenuScene.h"
@@ -7,7 +8,11 @@
 
 #include <SDL2/SDL.h>
 
+#include <array>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 /*
  * The World class is where all of the game logic happens, with things
@@ -30,8 +35,20 @@ class Game {
 
    void init();
 
+   // Collects the window events and the keyboard state, has to be called on the main thread
+   void pollEvents();
+
+   // Passes the last polled keyboard state, or the next tick of a recording that is played back,
+   // on to the Input and the current scene
    void handleInput();
 
+   // Saves the input of every tick from now on
+   int startInputRecording(const std::string& path);
+   void stopInputRecording();
+
+   // Uses the recorded input instead of the keyboard, and quits once the recording is over
+   int startInputPlayback(const std::string& path);
+
    void update();
 
    void setCore(Core* core);
@@ -42,4 +59,12 @@ class Game {
    Scenes currentScene;
 
    std::unique_ptr<Scene> scene;
+
+   // Written by pollEvents() and read by handleInput(), which may run on another thread
+   std::mutex inputMutex;
+   std::array<Uint8, SDL_NUM_SCANCODES> keyboardState{};
+   std::vector<SDL_Scancode> pressedRawKeys;
+
+   InputRecorder inputRecorder;
+   InputPlayer inputPlayer;
 };
@@ -2,7 +2,8 @@
 
 #include <SDL2/SDL.h>
 
-#include <unordered_map>
+#include <array>
+#include <bitset>
 #include <vector>
 
 enum class Key : int
@@ -21,8 +22,18 @@ enum class Key : int
    MENU_ACCEPT,  // Select the current option
    MENU_ESCAPE,
    PAUSE,
+   COUNT
 };
 
+// One bit for each Key, set while the key is down
+using KeySet = std::bitset<(int)Key::COUNT>;
+
+/*
+ * The Input keeps the key that each action is bound to, and which actions are down. An action is
+ * pressed on the tick that its key goes down, and held on every tick after that until it is let
+ * go of. Everything is indexed by the Key, so updating it is a pass over a small array.
+ * */
+
 class Input {
   public:
    static Input& Get() {
@@ -35,6 +46,15 @@ class Input {
 
    void update(const Uint8* keystates);
 
+   // Updates from the actions that are down instead of the keyboard, such as when a recording is
+   // played back
+   void update(KeySet keysDown);
+
+   // The actions that were down on the last update, which is what an InputRecorder saves
+   KeySet getKeysDown() const {
+      return keysDown;
+   }
+
    SDL_Scancode getBoundKey(Key action);
 
    bool getRawKey(Key action);
@@ -56,7 +76,7 @@ class Input {
 
    std::vector<SDL_Scancode> currentRawKeys;  // All keys on the keyboard
 
-   std::unordered_map<Key, SDL_Scancode> keyBindings;
-   std::unordered_map<Key, bool> keysPressed;
-   std::unordered_map<Key, bool> keysHeld;
+   std::array<SDL_Scancode, (int)Key::COUNT> keyBindings{};
+   KeySet keysDown;
+   KeySet keysHeld;  // Down on this update and the one before
 };
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Input.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/*
+ * An input recording holds the actions that were down on every tick, so a run can be played
+ * again with exactly the same input. Pressed and held are worked out from the actions that are
+ * down, like they are when the keyboard is used, so only those are saved.
+ *
+ * The file starts with "SMBINPUT", a version and the number of Keys, followed by runs of ticks
+ * that had the same actions down. Each run is two little endian 16 bit numbers: a bit for each
+ * Key, then how many ticks in a row it lasted, so a recording only grows when the keys change.
+ * */
+
+class InputRecorder {
+  public:
+   InputRecorder() = default;
+
+   InputRecorder(const InputRecorder&) = delete;
+
+   ~InputRecorder();
+
+   int start(const std::string& path);
+
+   // Adds one tick
+   void record(KeySet keysDown);
+
+   void stop();
+
+   bool isRecording() const {
+      return file.is_open();
+   }
+
+  private:
+   void writeRun();
+
+   std::string path;
+   std::ofstream file;
+
+   uint16_t runKeys = 0;
+   uint16_t runLength = 0;
+
+   int tickCount = 0;
+};
+
+class InputPlayer {
+  public:
+   // Reads the whole recording, it is small enough
+   int start(const std::string& path);
+
+   // Gives the actions that are down on the next tick. Returns false on the tick after the
+   // recording ended, and nothing is down then
+   bool next(KeySet& keysDown);
+
+   bool isPlaying() const {
+      return playing;
+   }
+
+  private:
+   struct Run {
+      uint16_t keys;
+      uint16_t length;
+   };
+
+   std::string path;
+
+   std::vector<Run> runs;
+   std::size_t currentRun = 0;
+   uint16_t runTick = 0;
+
+   int tickCount = 0;
+   bool playing = false;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Level.h"
+#include "Map.h"
+#include "util/MappedFile.h"
+
+#include <cstdint>
+#include <string>
+
+/*
+ * A LevelFile is a level compiled into one binary file by the LevelCompiler (make levels). It holds
+ * the six tile layers as int16 grids and the level properties as already parsed records, so
+ * loading a level maps the file into memory instead of parsing the CSV files and properties.
+ *
+ * The file remembers the size and modification time of every source it was compiled from. If any
+ * of them changed since, the file isn't used and the level is loaded from the CSV files instead.
+ * */
+
+enum class LevelLayer
+{
+   FOREGROUND,
+   BACKGROUND,
+   UNDERGROUND,
+   ENEMIES,
+   ABOVE_FOREGROUND,
+   COLLECTIBLES,
+   COUNT
+};
+
+class LevelFile {
+  public:
+   static constexpr uint32_t VERSION = 1;
+
+   LevelFile() = default;
+
+   // The map data path is the path to the level files without their suffix,
+   // e.g. res/data/World1-1/World1-1. Returns the size of the compiled file, or -1 if it failed
+   static int compile(const std::string& mapDataPath);
+
+   // Returns false if the compiled level is missing, invalid or out of date
+   bool open(const std::string& mapDataPath);
+
+   void close();
+
+   // The layer points into the mapped file, so it is only valid until the file is closed
+   TileLayerView getLayer(LevelLayer layer) const;
+
+   void loadLevelData(LevelData& data) const;
+
+   static std::string getLayerPath(const std::string& mapDataPath, LevelLayer layer);
+
+   static std::string getPropertiesPath(const std::string& mapDataPath) {
+      return mapDataPath + ".levelproperties";
+   }
+
+   static std::string getCompiledPath(const std::string& mapDataPath) {
+      return mapDataPath + ".level";
+   }
+
+  private:
+   LevelFile(const LevelFile&) = delete;
+
+   template <typename T>
+   const T* at(uint32_t offset) const {
+      return reinterpret_cast<const T*>(file.data() + offset);
+   }
+
+   bool isValid() const;
+
+   MappedFile file;
+};
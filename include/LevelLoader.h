@@ -0,0 +1,60 @@
+#pragma once
+
+#include "ECS/ECS.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+/*
+ * Runs the function that creates the entities of a level on a separate thread. Every entity it
+ * creates is staged instead of being added to the world, so the systems ticking the world never
+ * see a half built level. Once isFinished() is true, publish() adds all of them at once.
+ * */
+
+class LevelLoader {
+  public:
+   LevelLoader() = default;
+
+   LevelLoader(const LevelLoader&) = delete;
+
+   // Waits for a load that is still running, and deletes entities that were never published
+   ~LevelLoader();
+
+   void start(World* world, std::function<void(World*)> loadEntities);
+
+   bool isFinished() const {
+      return finished;
+   }
+
+   // Waits for the loader thread and adds the staged entities to the world
+   void publish();
+
+   int getEntityCount() const {
+      return entityCount;
+   }
+
+   // How long the loader thread took to create the entities
+   double getLoadMilliseconds() const {
+      return loadMilliseconds;
+   }
+
+  private:
+   void run(std::function<void(World*)> loadEntities);
+
+   void join();
+
+   // Entities left over from a load that was never published
+   void deleteStagedEntities();
+
+   World* world = nullptr;
+
+   std::thread loaderThread;
+   std::atomic<bool> finished{true};
+
+   std::vector<Entity*> stagedEntities;
+   int entityCount = 0;
+   double loadMilliseconds = 0.0;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+// The kinds of level objects that a .levelproperties file describes. They are kept apart from the
+// components that use them, so the level tools can read levels without the game's runtime
+
+enum class Direction
+{
+   NONE,
+   UP,
+   DOWN,
+   LEFT,
+   RIGHT
+};
+
+enum class PlatformMotionType
+{
+   NONE,
+   ONE_DIRECTION_REPEATED,    // Moves in one direction, but goes to min point when it reaches max
+   ONE_DIRECTION_CONTINUOUS,  // Continuously moving in one direction
+   BACK_AND_FORTH,            // Moves back and forth
+   GRAVITY                    // Affected by Gravity when mario stands on it
+};
+
+enum class RotationDirection
+{
+   NONE,
+   CLOCKWISE,
+   COUNTER_CLOCKWISE,
+};
+
+enum class MysteryBoxType
+{
+   NONE,
+   MUSHROOM,
+   COINS,
+   SUPER_STAR,
+   ONE_UP,
+   VINES
+};
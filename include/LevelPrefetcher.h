@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Level.h"
+#include "LevelFile.h"
+#include "Map.h"
+#include "SMBMath.h"
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * A PreparedLevel is everything that is read from a level's files: its properties and its six
+ * tile layers. Loading one doesn't touch the game, so it can be done on any thread. Once loaded
+ * it is never changed, the game plays on a copy of it.
+ * */
+
+struct PreparedLevel {
+   int level = 0;
+   int subLevel = 0;
+
+   LevelData data{};
+
+   Map foregroundMap;
+   Map backgroundMap;
+   Map undergroundMap;
+   Map enemiesMap;
+   Map aboveForegroundMap;
+   Map collectiblesMap;
+
+   // How long reading each layer and the properties took, the layers are indexed by LevelLayer
+   std::array<double, (int)LevelLayer::COUNT> layerMilliseconds{};
+   double propertiesMilliseconds = 0.0;
+
+   // Reads the compiled level if it is up to date. Otherwise the CSV files and the properties are
+   // read at the same time, one thread each
+   void load(int level, int subLevel);
+
+   Map& getMap(LevelLayer layer);
+};
+
+/*
+ * Keeps every level that was loaded during the session, so restarting a level or going back to
+ * one doesn't read any files again. The levels that the player can go to next are prepared on a
+ * background thread while the current level is being played, one at a time in the order they
+ * were asked for.
+ * */
+
+class LevelPrefetcher {
+  public:
+   LevelPrefetcher() = default;
+
+   LevelPrefetcher(const LevelPrefetcher&) = delete;
+
+   // Stops the background thread, a level that is being prepared is finished first
+   ~LevelPrefetcher();
+
+   // The levels that the given level leads to: the next level and the targets of its warp pipes
+   static std::vector<Vector2i> findNextLevels(int level, int subLevel, const LevelData& data);
+
+   // Replaces the levels waiting to be prepared, levels that are already cached are skipped
+   void prefetch(const std::vector<Vector2i>& levels);
+
+   // Returns the cached level. If it is being prepared right now this waits for it to finish,
+   // and if it was never prepared it is loaded on the calling thread. cached is set to whether
+   // it was already in the cache, a level that had to be waited for was not
+   std::shared_ptr<const PreparedLevel> get(int level, int subLevel, bool* cached = nullptr);
+
+  private:
+   void run();
+
+   std::mutex mutex;
+   std::condition_variable condition;
+
+   std::thread prefetchThread;
+   bool stopping = false;
+
+   std::deque<Vector2i> pending;
+   CoordinateIndex<std::shared_ptr<const PreparedLevel>> cache;
+
+   // The level that the background thread is preparing, (0, 0) if it is idle
+   Vector2i preparing;
+};
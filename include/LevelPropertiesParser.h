@@ -0,0 +1,90 @@
+#pragma once
+
+#include "SMBMath.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct LevelData;
+
+/*
+ * Reads a .levelproperties file in a single pass. Every line is blank, a # comment, a property
+ * (KEY = value), or the start of an array (KEY=\). The elements of an array follow one per line,
+ * each ending with ",\" except for the last, until the first line that isn't an element.
+ *
+ * Problems are reported with the line and column they were found on. The element or property
+ * with the problem is skipped and the rest of the file is still parsed.
+ * */
+
+class LevelPropertiesParser {
+  public:
+   struct Error {
+      int line;
+      int column;
+      std::string message;
+   };
+
+   LevelPropertiesParser(LevelData& data) : data{data} {}
+
+   // Returns false if there were any errors
+   bool parse(std::string_view text);
+
+   const std::vector<Error>& getErrors() const {
+      return errors;
+   }
+
+  private:
+   enum class Key
+   {
+      NONE,
+      PLAYER_START,
+      CAMERA_START,
+      CAMERA_MAX,
+      LEVEL_TYPE,
+      NEXT_LEVEL,
+      BACKGROUND_COLOR,
+      TELEPORT_POINT,
+      FLOATING_TEXT,
+      WARP_PIPE,
+      MOVING_PLATFORM,
+      PLATFORM_LEVEL,
+      FIRE_BAR,
+      VINE
+   };
+
+   static Key findKey(std::string_view name);
+
+   static bool isArray(Key key);
+
+   void parseProperty(Key key);
+
+   void parseElement(Key key);
+
+   bool readPoint(Vector2i& point);
+   bool readInt(int& value);
+   bool readBool(bool& value);
+   bool readWord(std::string_view& word);
+   bool readText(std::string& text);
+
+   template <typename T>
+   bool readEnum(T& value);
+
+   void skipSpaces();
+
+   bool expect(char character);
+
+   // Fails if there is anything but whitespace left on the line
+   bool expectEnd();
+
+   void addError(const std::string& message);
+
+   LevelData& data;
+
+   std::vector<Error> errors;
+
+   // The line that is being parsed
+   std::string_view line;
+   std::size_t column = 0;
+   int lineNumber = 0;
+};
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "SMBMath.h"
+#include "SpriteIDTable.h"
+#include "TileGrid.h"
 
-#include <unordered_map>
+#include <array>
+#include <cstdint>
 #include <vector>
 
 /*
@@ -12,6 +15,17 @@
 
 using std::vector;
 
+// A view into one of the tile layers of a compiled LevelFile, only valid while the file is open
+struct TileLayerView {
+   const int16_t* tiles = nullptr;
+   int width = 0;
+   int height = 0;
+
+   int get(int x, int y) const {
+      return tiles[y * width + x];
+   }
+};
+
 class Map {
   public:
    Map();
@@ -19,23 +33,48 @@ class Map {
 
    ~Map() = default;
 
+   Map(const Map&) = default;
+   Map& operator=(const Map&) = default;
+   Map(Map&&) = default;
+   Map& operator=(Map&&) = default;
+
    void loadMap(const char* dataPath);
+   void loadMap(const TileLayerView& layer);
 
    void reset();
 
-   static void loadBlockIDS();
-   static void loadPlayerIDS();
-   static void loadEnemyIDS();
+   // Reads the blocks that don't follow the layout of the block sheet, only the first call does
+   // anything
    static void loadIrregularBlockReferences();
 
-   vector<vector<int>> getLevelData();
+   // Gets the Block ID that is equivalent to its ID in the Overworld, or -1
+   static int getReferenceBlockID(int blockID) {
+      return BlockIDCoordinates.contains(blockID) ? ReferenceBlockIDs[blockID] : -1;
+   }
 
-   static std::unordered_map<int, Vector2i> BlockIDCoordinates;
-   static std::unordered_map<int, Vector2i> PlayerIDCoordinates;
-   static std::unordered_map<int, Vector2i> EnemyIDCoordinates;
-   static std::unordered_map<int, int> DeadEnemyIDCoordinates;
-   static std::unordered_map<int, int> IrregularBlockReferences;
+   // Gets the Enemy ID that is equivalent to its ID in the Overworld, or -1
+   static int getReferenceEnemyID(int enemyID) {
+      return EnemyIDCoordinates.contains(enemyID) ? ReferenceEnemyIDs[enemyID] : -1;
+   }
+
+   const TileGrid& getLevelData() const {
+      return levelData;
+   }
+
+   static constexpr int BLOCK_SHEET_COLUMNS = 48;
+   static constexpr int BLOCK_SHEET_ROWS = 22;
+   static constexpr int PLAYER_SHEET_COLUMNS = 25;
+   static constexpr int PLAYER_SHEET_ROWS = 16;
+   static constexpr int ENEMY_SHEET_COLUMNS = 35;
+   static constexpr int ENEMY_SHEET_ROWS = 15;
+
+   static const SpriteIDTable BlockIDCoordinates;
+   static const SpriteIDTable PlayerIDCoordinates;
+   static const SpriteIDTable EnemyIDCoordinates;
 
   private:
-   vector<vector<int>> levelData;
+   static std::array<int, BLOCK_SHEET_COLUMNS * BLOCK_SHEET_ROWS> ReferenceBlockIDs;
+   static const std::array<int, ENEMY_SHEET_COLUMNS * ENEMY_SHEET_ROWS> ReferenceEnemyIDs;
+
+   TileGrid levelData;
 };
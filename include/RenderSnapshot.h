@@ -0,0 +1,90 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * A RenderSnapshot is everything needed to draw one frame, copied out of the World by the
+ * RenderSystem. Once it is published it is never changed, so the thread that issues the SDL
+ * renderer calls can draw it while the simulation is already working on the next frame.
+ * */
+
+enum class BackgroundColor
+{
+   NONE,
+   BLACK,
+   BLUE
+};
+
+struct SpriteDrawCommand {
+   std::shared_ptr<SDL_Texture> texture;
+   SDL_Rect sourceRect;
+   SDL_Rect destinationRect;
+   bool horizontalFlipped;
+   bool verticalFlipped;
+};
+
+struct TextDrawCommand {
+   std::string text;
+   SDL_Rect destinationRect;
+   std::size_t spritesBefore;  // How many sprites get drawn before this text
+};
+
+struct RenderSnapshot {
+   BackgroundColor backgroundColor = BackgroundColor::NONE;
+
+   std::vector<SpriteDrawCommand> sprites;
+   std::vector<TextDrawCommand> texts;
+
+   void clear() {
+      sprites.clear();
+      texts.clear();
+   }
+};
+
+/*
+ * Three snapshots are rotated between the simulation and the renderer: one being written, one
+ * being drawn, and the most recently published one. Neither side ever waits for the other, the
+ * renderer just skips any snapshots it was too slow to draw.
+ * */
+class RenderSnapshotBuffer {
+  public:
+   RenderSnapshotBuffer() = default;
+
+   // The snapshot that the simulation should fill in next
+   RenderSnapshot& getWriteSnapshot() {
+      return snapshots[writeIndex];
+   }
+
+   void publish() {
+      writeIndex = latestIndex.exchange(writeIndex | FRESH_BIT) & INDEX_MASK;
+   }
+
+   // Returns the newest published snapshot, or nullptr if it has already been drawn
+   const RenderSnapshot* acquireLatest() {
+      if (!(latestIndex.load() & FRESH_BIT)) {
+         return nullptr;
+      }
+
+      readIndex = latestIndex.exchange(readIndex) & INDEX_MASK;
+
+      return &snapshots[readIndex];
+   }
+
+  private:
+   RenderSnapshotBuffer(const RenderSnapshotBuffer&) = delete;
+
+   static constexpr int INDEX_MASK = 0b011;
+   static constexpr int FRESH_BIT = 0b100;
+
+   std::array<RenderSnapshot, 3> snapshots;
+
+   int writeIndex = 0;
+   int readIndex = 1;
+   std::atomic<int> latestIndex{2};
+};
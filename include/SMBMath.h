@@ -13,9 +13,9 @@ class Vector2 {
    using VectorType = T;
 
   public:
-   Vector2() : x{0}, y{0} {};
-   Vector2(T X, T Y) : x{X}, y{Y} {};
-   Vector2(T BOTH) : x{BOTH}, y{BOTH} {};
+   constexpr Vector2() : x{0}, y{0} {};
+   constexpr Vector2(T X, T Y) : x{X}, y{Y} {};
+   constexpr Vector2(T BOTH) : x{BOTH}, y{BOTH} {};
 
    void setPosition(T X, T Y) {
       x = X;
@@ -1,9 +1,16 @@
 #pragma once
 
-#include <SDL2/SDL_mixer.h>
+#include "AudioBackend.h"
 
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 enum class SoundID
 {
@@ -27,7 +34,8 @@ enum class SoundID
    SHRINK,
    STOMP,
    TIMER_TICK,
-   CASTLE_CLEAR
+   CASTLE_CLEAR,
+   COUNT
 };
 
 enum class MusicID
@@ -37,22 +45,51 @@ enum class MusicID
    CASTLE,
    UNDERWATER,
    SUPER_STAR,
-   GAME_WON
+   GAME_WON,
+   COUNT
 };
 
+// What a sound does when every channel is already playing something
+enum class StealPolicy
+{
+   NONE,            // The sound is dropped
+   LOWER,           // Takes over the channel of a sound with a lower priority
+   LOWER_OR_EQUAL,  // Also takes over a sound with the same priority
+};
+
+struct SoundSettings {
+   int priority;
+   StealPolicy steal;
+   int cooldownTicks;  // The sound isn't started again until this many ticks have passed
+};
+
+constexpr int DEFAULT_SOUND_CHANNELS = 8;
+
+// How much loaded music is kept before the least recently used music is let go of
+constexpr std::size_t DEFAULT_MUSIC_BUDGET = 4 * 1024 * 1024;
+
+/*
+ * Sounds and music are loaded the first time that they are played, or ahead of time on a
+ * background thread when something hints that they will be needed soon. Sounds are kept once
+ * they are loaded. Music is let go of, least recently used first, when it goes over the budget,
+ * but never while it is playing.
+ * */
+
 class SoundManager {
   public:
    static SoundManager& Get() {
       return instance;
    }
 
-   int Init();
+   int Init(std::unique_ptr<AudioBackend> backend, int channelCount = DEFAULT_SOUND_CHANNELS,
+            std::size_t musicBudget = DEFAULT_MUSIC_BUDGET);
    int Quit();
 
-   std::shared_ptr<Mix_Chunk> loadSound(const char* path);
-
-   std::shared_ptr<Mix_Music> loadMusic(const char* path);
+   AudioBackend& getBackend() {
+      return *backend;
+   }
 
+   // Plays the sound on a free channel, or on one taken from a less important sound
    void playSound(SoundID sound);
    void playMusic(MusicID music);
 
@@ -63,16 +100,115 @@ class SoundManager {
    void resumeMusic();
    void stopMusic();
 
+   // Loads the sound or music on the background thread if it isn't loaded yet
+   void preloadSound(SoundID sound);
+   void preloadMusic(MusicID music);
+
+   // Moves the clock that the cooldowns use on by one tick, and lets the backend mix the tick
+   // that just ended. Called by the SoundSystem after it played the tick's sounds
+   void nextTick();
+
+   // Sounds that didn't get a channel
+   int getDroppedCount() const {
+      return droppedCount;
+   }
+
+   // Sounds that were cut off by a more important one
+   int getStolenCount() const {
+      return stolenCount;
+   }
+
+   // Sounds that were left out because they were still cooling down
+   int getLimitedCount() const {
+      return limitedCount;
+   }
+
+   // How many files were loaded, how long that took in total, and how many bytes they hold now
+   void printLoadReport();
+
   private:
    SoundManager() {}
 
    SoundManager(const SoundManager&) = delete;
 
+   // A sound or music that is being preloaded is finished first
+   ~SoundManager();
+
    static SoundManager instance;
 
-   void loadSounds();
-   void loadMusics();
+   struct AudioFile {
+      AudioData data;
+      std::size_t bytes = 0;
+      uint64_t lastUsed = 0;
+      bool loading = false;
+      bool failed = false;
+   };
+
+   // Returns the loaded sound or music, loading it on this thread or waiting for the background
+   // thread if it isn't loaded yet. nullptr if the file couldn't be loaded
+   AudioData getSound(SoundID sound);
+   AudioData getMusic(MusicID music);
+
+   // Loads the file with the mutex unlocked, since loading can take a while
+   template <typename Loader>
+   void loadFile(std::unique_lock<std::mutex>& lock, AudioFile& file, Loader load);
+
+   AudioData loadSoundFile(SoundID sound);
+   AudioData loadMusicFile(MusicID music);
+
+   // Lets go of the least recently used music until the loaded music fits in the budget, the
+   // music that is about to play is kept
+   void evictMusic(int keptMusic);
+
+   void runPreloader();
+
+   void stopPreloader();
+
+   struct PreloadRequest {
+      bool music;
+      int id;
+   };
+
+   // Returns -1 if the sound can't get a channel
+   int findChannel(const SoundSettings& settings);
+
+   // What is playing on each channel, only valid while the backend says the channel is busy
+   struct Voice {
+      SoundID sound;
+      int priority;
+      uint64_t startTick;
+   };
+
+   std::vector<Voice> voices;
+
+   std::array<uint64_t, (int)SoundID::COUNT> cooldownEnds{};
+   uint64_t tick = 0;
+
+   int droppedCount = 0;
+   int stolenCount = 0;
+   int limitedCount = 0;
+
+   std::mutex mutex;
+   std::condition_variable condition;
+
+   std::unique_ptr<AudioBackend> backend;
+
+   std::array<AudioFile, (int)SoundID::COUNT> sounds;
+   std::array<AudioFile, (int)MusicID::COUNT> musics;
+
+   std::size_t musicBudget = DEFAULT_MUSIC_BUDGET;
+   std::size_t loadedBytes = 0;
+   std::size_t peakBytes = 0;
+
+   // The music that is playing right now, -1 if none is
+   int currentMusic = -1;
+   uint64_t useCount = 0;
+
+   int loadCount = 0;
+   int evictedCount = 0;
+   double loadMilliseconds = 0.0;
 
-   std::unordered_map<SoundID, std::shared_ptr<Mix_Chunk>> sounds;
-   std::unordered_map<MusicID, std::shared_ptr<Mix_Music>> musics;
+   std::thread preloadThread;
+   std::deque<PreloadRequest> preloadRequests;
+   bool stopping = false;
 };
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "SMBMath.h"
+
+#include <array>
+#include <stdexcept>
+#include <string>
+
+/*
+ * The sprites on a sheet are numbered from left to right, top to bottom. A SpriteIDTable maps
+ * every ID of a sheet to the column and row of its sprite, using an array that is generated at
+ * compile time by makeSpriteIDCoordinates(), so a lookup is a single array read.
+ * */
+
+template <int COLUMNS, int ROWS>
+constexpr std::array<Vector2i, COLUMNS * ROWS> makeSpriteIDCoordinates() {
+   std::array<Vector2i, COLUMNS * ROWS> coordinates{};
+
+   for (int id = 0; id < COLUMNS * ROWS; id++) {
+      coordinates[id] = Vector2i(id % COLUMNS, id / COLUMNS);
+   }
+
+   return coordinates;
+}
+
+class SpriteIDTable {
+  public:
+   constexpr SpriteIDTable(const Vector2i* coordinates, int columns, int rows)
+       : coordinates{coordinates}, columns{columns}, rows{rows} {}
+
+   // Throws std::out_of_range for IDs that aren't on the sheet
+   const Vector2i& at(int id) const {
+      if (!contains(id)) {
+         throw std::out_of_range("Sprite ID " + std::to_string(id) + " is not on the sheet");
+      }
+      return coordinates[id];
+   }
+
+   constexpr bool contains(int id) const {
+      return id >= 0 && id < columns * rows;
+   }
+
+   // Returns the ID of the sprite at the coordinate, or -1 if it's outside of the sheet
+   constexpr int getID(int x, int y) const {
+      return (x >= 0 && y >= 0 && x < columns && y < rows) ? y * columns + x : -1;
+   }
+
+   constexpr int size() const {
+      return columns * rows;
+   }
+
+  private:
+   const Vector2i* coordinates;
+   int columns;
+   int rows;
+};
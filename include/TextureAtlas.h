@@ -0,0 +1,84 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * The TextureAtlas packs every PNG under res/sprites onto a few large pages at startup, so sprites
+ * from different sheets are drawn from the same texture and the renderer can batch them. The
+ * packed pages and their layout are saved to disk and reused until one of the sprites changes.
+ *
+ * A sheet in the atlas is handed out as a shared_ptr to its page, with an AtlasRegion as the
+ * deleter. Code that only passes the texture around doesn't need to know about the atlas, only the
+ * RenderSystem moves the source rects onto the sheet's area of the page.
+ * */
+
+struct AtlasRegion {
+   std::shared_ptr<SDL_Texture> page;  // Keeps the page alive as long as the sheet is used
+   SDL_Rect area;
+
+   // The page is destroyed by its own deleter, the sheet itself owns nothing
+   void operator()(SDL_Texture*) {}
+};
+
+class TextureAtlas {
+  public:
+   TextureAtlas() = default;
+
+   // Loads the cached pages, or packs the sprites again if they changed. Has to be called on the
+   // render thread
+   int build(SDL_Renderer* renderer, const std::string& spriteDirectory,
+             const std::string& cacheDirectory);
+
+   void clear();
+
+   // Returns nullptr if the image isn't in the atlas, or was packed with a different color key
+   std::shared_ptr<SDL_Texture> getSheet(const std::string& path, bool blueTransparent);
+
+   // The area of the page that the texture draws from, nullptr if it isn't from the atlas
+   static const SDL_Rect* getArea(const std::shared_ptr<SDL_Texture>& texture) {
+      const AtlasRegion* region = std::get_deleter<AtlasRegion>(texture);
+      return (region) ? &region->area : nullptr;
+   }
+
+  private:
+   TextureAtlas(const TextureAtlas&) = delete;
+
+   struct Entry {
+      std::string path;
+      std::uintmax_t fileSize;
+      long long modifiedTime;
+
+      int page;
+      SDL_Rect area;
+      bool keyed;  // Whether the color key made any of the pixels transparent
+   };
+
+   static constexpr int PAGE_SIZE = 2048;
+   static constexpr int PADDING = 1;  // Empty pixels between sheets, so filtering can't bleed
+   static constexpr int LAYOUT_VERSION = 1;
+
+   std::vector<Entry> findSprites(const std::string& spriteDirectory);
+
+   bool loadCache(SDL_Renderer* renderer, const std::string& cacheDirectory,
+                  std::vector<Entry>& sprites);
+
+   int pack(SDL_Renderer* renderer, const std::string& cacheDirectory,
+            std::vector<Entry>& sprites);
+
+   void saveCache(const std::string& cacheDirectory, const std::vector<Entry>& sprites,
+                  const std::vector<SDL_Surface*>& pageSurfaces);
+
+   bool addPage(SDL_Renderer* renderer, SDL_Surface* surface);
+
+   // Makes the pixels in the key color transparent, returns whether there were any
+   static bool applyColorKey(SDL_Surface* surface);
+
+   std::vector<std::shared_ptr<SDL_Texture>> pages;
+   std::unordered_map<std::string, Entry> entries;
+};
@@ -1,18 +1,28 @@
 #pragma once
 
 #include "ECS/ECS.h"
+#include "FrameCapture.h"
+#include "RenderSnapshot.h"
+#include "TextureAtlas.h"
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
-enum class BackgroundColor
-{
-   NONE,
-   BLACK,
-   BLUE
-};
+/*
+ * The TextureManager owns the window and the renderer. Every SDL renderer call has to happen on
+ * the thread that called Init(), the render thread. The simulation only describes frames through
+ * RenderSnapshots, and textures it loads are created and destroyed on the render thread for it.
+ *
+ * Sprite sheets are handed out from the TextureAtlas when they were packed into it.
+ * */
 
 class TextureManager {
   public:
@@ -20,23 +30,44 @@ class TextureManager {
       return instance;
    }
 
-   int Init();
+   // Headless mode uses SDL's dummy video driver and a software renderer that draws onto an
+   // offscreen surface, so the game can run on machines without a display or GPU
+   // In low resolution mode the world is drawn at the original 16 pixel tile size into a
+   // render target, which is scaled up to the window once per frame
+   int Init(bool headless = false, bool lowResolution = false);
    int Quit();
 
+   // Saves every Nth displayed frame, see FrameCapture for the formats
+   int StartCapture(CaptureFormat format, const std::string& path, int interval);
+
    SDL_Texture* LoadTexture(const char* path);
    std::shared_ptr<SDL_Texture> LoadSharedTexture(const char* path, bool blueTransparent = true);
    std::shared_ptr<TTF_Font> LoadSharedFont(const char* path, int fontSize);
    void Draw(SDL_Texture* texture, SDL_Rect destRect);
    void Draw(SDL_Texture* texture, SDL_Rect sourceRect, SDL_Rect destRect);
-   void Draw(std::shared_ptr<SDL_Texture>, SDL_Rect sourceRect, SDL_Rect destRect, bool horizontal,
-             bool vertical);
+   void Draw(const std::shared_ptr<SDL_Texture>& texture, SDL_Rect sourceRect, SDL_Rect destRect,
+             bool horizontal, bool vertical);
    void Draw(std::shared_ptr<TTF_Font> font, const char* text, SDL_Rect position);
+   void DrawText(const std::string& text, SDL_Rect position);
    void DrawHorizontalFlipped(std::shared_ptr<SDL_Texture>, SDL_Rect sourceRect, SDL_Rect destRect);
    void DrawVerticalFlipped(std::shared_ptr<SDL_Texture>, SDL_Rect sourceRect, SDL_Rect destRect);
    void SetBackgroundColor(BackgroundColor color);
-   void Clear();
+   void Clear(BackgroundColor color);
    void Display();
 
+   // The snapshot that the RenderSystem fills in, and then publishes once the frame is complete
+   RenderSnapshot& BeginSnapshot();
+   void PublishSnapshot();
+
+   // Draws and presents the newest published snapshot, returns false if it was already drawn
+   bool DrawLatestSnapshot();
+
+   // Runs the task on the render thread and waits for it to finish
+   void RunOnRenderThread(const std::function<void()>& task);
+
+   // Runs the tasks queued by other threads, has to be called regularly by the render thread
+   void RunRenderTasks();
+
    void ResizeWindow();
 
    SDL_Renderer* getRenderer() {
@@ -47,6 +78,10 @@ class TextureManager {
       return currentColor;
    }
 
+   bool isHeadless() {
+      return headless;
+   }
+
   private:
    TextureManager() {}
 
@@ -54,7 +89,46 @@ class TextureManager {
 
    static TextureManager instance;
 
-   SDL_Window* window;
-   SDL_Renderer* renderer;
+   struct CachedText {
+      SDL_Texture* texture;
+      int lastUsedFrame;
+   };
+
+   static constexpr int TEXT_CACHE_LIFETIME = 60;  // Frames an unused text texture is kept for
+
+   void DestroyTexture(SDL_Texture* texture);
+
+   void EvictUnusedText();
+
+   int SetupRenderer();
+
+   // Draws the sprites into the world target, scales it up, and draws the text over it
+   void DrawLowResolution(const RenderSnapshot& snapshot);
+
+   bool onRenderThread() {
+      return std::this_thread::get_id() == renderThreadID;
+   }
+
+   SDL_Window* window = nullptr;
+   SDL_Renderer* renderer = nullptr;
+   SDL_Surface* offscreenSurface = nullptr;  // Render target when running headless
+   SDL_Texture* worldTarget = nullptr;       // Render target for the world in low resolution mode
    BackgroundColor currentColor;
+
+   FrameCapture frameCapture;
+
+   TextureAtlas textureAtlas;
+
+   RenderSnapshotBuffer snapshotBuffer;
+   int drawnFrames = 0;
+
+   std::shared_ptr<TTF_Font> textFont;
+   std::unordered_map<std::string, CachedText> textCache;
+
+   std::thread::id renderThreadID;
+   std::mutex renderTaskMutex;
+   std::vector<std::function<void()>> renderTasks;
+
+   bool headless = false;
+   bool lowResolution = false;
 };
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+/*
+ * A TileGrid stores one layer of a level as a single contiguous buffer of tile IDs, row by row.
+ * grid[y][x] reads a tile without any checks, while at(x, y) treats everything outside of the
+ * grid as an empty tile.
+ * */
+
+class TileGrid {
+  public:
+   static constexpr int EMPTY_TILE = -1;
+
+   // A read only view of one row of the grid
+   class Row {
+     public:
+      Row(const int* tiles, int width) : tiles{tiles}, width{width} {}
+
+      int operator[](int x) const {
+         return tiles[x];
+      }
+
+      int size() const {
+         return width;
+      }
+
+      const int* begin() const {
+         return tiles;
+      }
+
+      const int* end() const {
+         return tiles + width;
+      }
+
+     private:
+      const int* tiles;
+      int width;
+   };
+
+   TileGrid() = default;
+
+   // Adds a row at the bottom of the grid. The first row sets the width, later rows that are
+   // shorter are filled up with empty tiles and longer ones are cut off
+   template <typename Iterator>
+   void appendRow(Iterator rowBegin, Iterator rowEnd) {
+      if (height == 0) {
+         width = (int)std::distance(rowBegin, rowEnd);
+      }
+
+      std::size_t rowStart = tiles.size();
+      tiles.resize(rowStart + width, EMPTY_TILE);
+
+      for (int x = 0; x < width && rowBegin != rowEnd; x++, ++rowBegin) {
+         tiles[rowStart + x] = *rowBegin;
+      }
+
+      height++;
+   }
+
+   void reserve(int width, int height) {
+      tiles.reserve((std::size_t)width * height);
+   }
+
+   void clear() {
+      tiles.clear();
+      width = 0;
+      height = 0;
+   }
+
+   Row operator[](int y) const {
+      return Row(tiles.data() + (std::size_t)y * width, width);
+   }
+
+   int get(int x, int y) const {
+      return tiles[(std::size_t)y * width + x];
+   }
+
+   int at(int x, int y) const {
+      return inBounds(x, y) ? get(x, y) : EMPTY_TILE;
+   }
+
+   bool inBounds(int x, int y) const {
+      return x >= 0 && y >= 0 && x < width && y < height;
+   }
+
+   int getWidth() const {
+      return width;
+   }
+
+   int getHeight() const {
+      return height;
+   }
+
+   bool empty() const {
+      return tiles.empty();
+   }
+
+   const std::vector<int>& getTiles() const {
+      return tiles;
+   }
+
+  private:
+   std::vector<int> tiles;
+
+   int width = 0;
+   int height = 0;
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+/*
+ * A TimerWheel keeps timers that expire after a number of ticks, without counting every one of
+ * them down on every tick. The first level has a slot for each of the next 256 ticks, and the
+ * second level has a slot for each of the 64 blocks of 256 ticks after that. When a block starts,
+ * its timers are moved down into the first level, and timers that are even further away wait in
+ * the last block until they fit. A tick only touches the timers that expire on it.
+ *
+ * Timers are linked into the slots directly, so scheduling and cancelling don't allocate.
+ * A timer cancels itself when it is destroyed.
+ * */
+
+class TimerWheel {
+  public:
+   class Timer {
+     public:
+      Timer() = default;
+
+      Timer(const Timer&) = delete;
+      Timer& operator=(const Timer&) = delete;
+
+      virtual ~Timer();
+
+      bool isScheduled() const {
+         return next != nullptr;
+      }
+
+     private:
+      friend class TimerWheel;
+
+      Timer* previous = nullptr;
+      Timer* next = nullptr;
+
+      TimerWheel* wheel = nullptr;
+      uint64_t expiry = 0;
+   };
+
+   TimerWheel() = default;
+
+   TimerWheel(const TimerWheel&) = delete;
+
+   // Timers that are still scheduled are let go of, they don't cancel themselves anymore
+   ~TimerWheel();
+
+   // The timer expires after the given number of ticks, at least one. A timer that was already
+   // scheduled is moved
+   void schedule(Timer* timer, int ticks);
+
+   void cancel(Timer* timer);
+
+   // Moves on by one tick, the timers that expired can then be taken with popExpired()
+   void advance();
+
+   // Returns nullptr once every expired timer was taken
+   Timer* popExpired();
+
+   // True if the last timer that was taken still exists and wasn't scheduled again, so it can be
+   // rescheduled after running it
+   bool isExpiring(const Timer* timer) const;
+
+   uint64_t getTick() const {
+      return tick;
+   }
+
+   int getScheduledCount() const {
+      return scheduledCount;
+   }
+
+  private:
+   static constexpr int NEAR_BITS = 8;
+   static constexpr int NEAR_SLOTS = 1 << NEAR_BITS;
+   static constexpr int FAR_SLOTS = 64;
+
+   // Every slot is a circular list that starts and ends at its sentinel
+   struct Slot {
+      Timer sentinel;
+
+      Slot() {
+         sentinel.previous = &sentinel;
+         sentinel.next = &sentinel;
+      }
+   };
+
+   void insert(Timer* timer);
+
+   static void link(Slot& slot, Timer* timer);
+   static void unlink(Timer* timer);
+
+   static void release(Slot& slot);
+
+   mutable std::mutex mutex;
+
+   std::array<Slot, NEAR_SLOTS> nearSlots;
+   std::array<Slot, FAR_SLOTS> farSlots;
+   Slot expired;
+
+   const Timer* expiring = nullptr;
+
+   uint64_t tick = 0;
+   int scheduledCount = 0;
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 class Command {
   public:
    Command() {}
@@ -9,4 +11,9 @@ class Command {
    virtual bool isFinished() {
       return true;
    }
+
+   // Every command lives in the CommandScheduler's pool, "new RunCommand(...)" and deleting a
+   // command go through these
+   static void* operator new(std::size_t size);
+   static void operator delete(void* memory, std::size_t size);
 };
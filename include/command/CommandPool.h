@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/*
+ * The CommandPool hands out the memory for every Command. Commands are sorted into size classes
+ * that are 16 bytes apart, and every class keeps the slots of finished commands in a free list,
+ * so once the game is running creating a command doesn't go to the heap anymore. Commands larger
+ * than the largest class are allocated normally. The memory is only given back when the game
+ * exits.
+ * */
+
+class CommandPool {
+  public:
+   CommandPool() = default;
+
+   ~CommandPool();
+
+   void* allocate(std::size_t size);
+
+   void release(void* memory, std::size_t size);
+
+   // The number of commands that exist right now, including the ones inside of sequences
+   int getLiveCount() const {
+      return liveCount;
+   }
+
+   // The most commands that existed at the same time
+   int getPeakCount() const {
+      return peakCount;
+   }
+
+  private:
+   CommandPool(const CommandPool&) = delete;
+
+   static constexpr std::size_t SLOT_ALIGNMENT = 16;
+   static constexpr std::size_t MAX_SLOT_SIZE = 256;
+   static constexpr std::size_t SIZE_CLASSES = MAX_SLOT_SIZE / SLOT_ALIGNMENT;
+
+   // How many slots are allocated at once when a size class runs out
+   static constexpr std::size_t SLOTS_PER_CHUNK = 32;
+
+   // A free slot holds the next free slot of its size class
+   struct FreeSlot {
+      FreeSlot* next;
+   };
+
+   static std::size_t getSizeClass(std::size_t size) {
+      return (size + SLOT_ALIGNMENT - 1) / SLOT_ALIGNMENT - 1;
+   }
+
+   void allocateChunk(std::size_t sizeClass);
+
+   // Commands are mostly created by the simulation thread, but the level loader can create them
+   // too
+   std::mutex mutex;
+
+   std::array<FreeSlot*, SIZE_CLASSES> freeSlots{};
+   std::vector<void*> chunks;
+
+   int liveCount = 0;
+   int peakCount = 0;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "command/Command.h"
+#include "command/CommandPool.h"
 
 #include <vector>
 
@@ -9,17 +10,26 @@ class CommandScheduler {
    CommandScheduler() {}
 
    void addCommand(Command* command);
+
+   // Runs every command in the order it was added. Commands added while running start on the
+   // next run
    void run();
 
    static CommandScheduler& getInstance();
 
+   static CommandPool& getPool();
+
+   // The number of commands waiting to be run, not counting the ones inside of sequences
+   int getQueuedCount() const {
+      return (int)commandQueue.size();
+   }
+
   private:
    CommandScheduler(const CommandScheduler&) = delete;
 
    static CommandScheduler instance;
 
-   void emptyDestroyQueue();
+   CommandPool pool;
 
    std::vector<Command*> commandQueue;
-   std::vector<Command*> destroyQueue;
 };
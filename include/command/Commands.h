@@ -1,6 +1,7 @@
 #include "DelayedCommand.h"
 #include "PrintCommand.h"
 #include "RunCommand.h"
+#include "ScriptCommand.h"
 #include "SequenceCommand.h"
 #include "VineCommand.h"
 #include "WaitCommand.h"
@@ -2,12 +2,11 @@
 
 #include "Constants.h"
 #include "command/Command.h"
-
-#include <functional>
+#include "util/InlineFunction.h"
 
 class DelayedCommand : public Command {
   public:
-   DelayedCommand(std::function<void()> onExecute, float delay) : onExecute{onExecute} {
+   DelayedCommand(InlineFunction<void()> onExecute, float delay) : onExecute{std::move(onExecute)} {
       if (delay >= 0) {
          ticks = (int)(delay * MAX_FPS);
       } else {
@@ -28,6 +27,6 @@ class DelayedCommand : public Command {
    }
 
   private:
-   std::function<void()> onExecute;
+   InlineFunction<void()> onExecute;
    int ticks;
 };
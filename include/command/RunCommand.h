@@ -1,20 +1,18 @@
 #pragma once
 
 #include "command/Command.h"
-#include "util/Supplier.h"
-
-#include <functional>
+#include "util/InlineFunction.h"
 
 class RunCommand : public Command {
   public:
-   RunCommand(std::function<void()> execute) : onExecute{execute} {
+   RunCommand(InlineFunction<void()> execute) : onExecute{std::move(execute)} {
       finishedSupplier = []() -> bool {
          return true;
       };
    }
 
-   RunCommand(std::function<void()> execute, BooleanSupplier finished)
-       : onExecute{execute}, finishedSupplier{finished} {}
+   RunCommand(InlineFunction<void()> execute, InlineFunction<bool()> finished)
+       : onExecute{std::move(execute)}, finishedSupplier{std::move(finished)} {}
 
    void execute() override {
       onExecute();
@@ -25,6 +23,6 @@ class RunCommand : public Command {
    }
 
   private:
-   std::function<void()> onExecute;
-   BooleanSupplier finishedSupplier;
+   InlineFunction<void()> onExecute;
+   InlineFunction<bool()> finishedSupplier;
 };
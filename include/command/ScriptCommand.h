@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Constants.h"
+#include "EventBus.h"
+#include "command/Command.h"
+#include "util/InlineFunction.h"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/*
+ * A ScriptCommand runs a list of steps one after the other, like a SequenceCommand, but the steps
+ * are stored inline in one vector instead of each being a separate command. A step is run once
+ * every tick until it says that it is done, and the next step starts on the tick after that.
+ *
+ *    new ScriptCommand(ScriptCommand::waitUntil([=]() { ... }),
+ *                      ScriptCommand::run([=]() { ... }),
+ *                      ScriptCommand::wait(0.5f))
+ * */
+
+class ScriptCommand : public Command {
+  public:
+   // Returns true once the step is done
+   using Step = InlineFunction<bool()>;
+
+   ScriptCommand() = default;
+
+   template <typename First, typename... Rest>
+   explicit ScriptCommand(First&& first, Rest&&... rest) {
+      addSteps(std::forward<First>(first), std::forward<Rest>(rest)...);
+   }
+
+   template <typename... Steps>
+   void addSteps(Steps&&... newSteps) {
+      steps.reserve(steps.size() + sizeof...(Steps));
+      (steps.emplace_back(std::forward<Steps>(newSteps)), ...);
+   }
+
+   // Runs the function once, like a RunCommand
+   template <typename Function>
+   static Step run(Function&& function) {
+      return [function = std::forward<Function>(function)]() mutable -> bool {
+         function();
+         return true;
+      };
+   }
+
+   // Waits for the given number of seconds, like a WaitCommand
+   static Step wait(float seconds) {
+      return waitTicks((seconds >= 0) ? (int)(seconds * MAX_FPS) : 0);
+   }
+
+   static Step waitTicks(int ticks) {
+      return [ticks]() mutable -> bool {
+         return --ticks <= 0;
+      };
+   }
+
+   // Waits until the condition is true, like a WaitUntilCommand
+   template <typename Condition>
+   static Step waitUntil(Condition&& condition) {
+      return [condition = std::forward<Condition>(condition)]() mutable -> bool {
+         return condition();
+      };
+   }
+
+   // Waits for an event about the entity that the filter accepts. The step subscribes when it
+   // starts and only looks at a flag after that, the filter runs when an event is published
+   template <typename Event, typename Filter>
+   static Step waitFor(Entity* entity, Filter&& filter) {
+      return [entity, filter = std::forward<Filter>(filter),
+              happened = std::make_shared<bool>(false),
+              subscription = EventBus::Subscription()]() mutable -> bool {
+         if (!subscription && !*happened) {
+            subscription = EventBus::Subscription(EventBus::Get().subscribe<Event>(
+                entity, [filter = std::move(filter), happened](const Event& event) mutable {
+                   return *happened = filter(event);
+                }));
+         }
+         return *happened;
+      };
+   }
+
+   void execute() override {
+      if (currentStep < steps.size() && steps[currentStep]()) {
+         currentStep++;
+      }
+   }
+
+   bool isFinished() override {
+      return currentStep >= steps.size();
+   }
+
+  private:
+   std::vector<Step> steps;
+   std::size_t currentStep = 0;
+};
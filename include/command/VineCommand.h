@@ -4,16 +4,14 @@
 #include "ECS/ECS.h"
 #include "SMBMath.h"
 #include "command/Command.h"
-#include "command/RunCommand.h"
-#include "command/SequenceCommand.h"
-#include "command/WaitUntilCommand.h"
+#include "command/ScriptCommand.h"
 #include "systems/PlayerSystem.h"
 #include "systems/WarpSystem.h"
 
 #include <iostream>
 #include <vector>
 
-class VineCommand : public SequenceCommand {
+class VineCommand : public ScriptCommand {
   public:
    VineCommand(GameScene* scene, WarpSystem* warpSystem, World* world, Entity* vine,
                Entity* player) {
@@ -35,12 +33,12 @@ class VineCommand : public SequenceCommand {
 
       std::vector<Entity*>& vineParts = vineComponent->vineParts;
 
-      addCommands(std::vector<Command*>{
+      addSteps(
           /* When the player is out of camera range, change the camera location */
-          new WaitUntilCommand([=]() -> bool {
+          ScriptCommand::waitUntil([=]() -> bool {
              return !Camera::Get().inCameraRange(playerPosition);
           }),
-          new RunCommand([=, &vineParts]() {
+          ScriptCommand::run([=, &vineParts]() {
              warpSystem->setTeleportCameraMax(Camera::Get().getCameraMaxX());
              Camera::Get().setCameraMaxX(vineComponent->newCameraMax * SCALED_CUBE_SIZE);
 
@@ -67,23 +65,23 @@ class VineCommand : public SequenceCommand {
                  SCALED_CUBE_SIZE / 2);
           }),
           /* Wait until the vine has fully moved up, and then stop the vines from growing more */
-          new WaitUntilCommand([=, &vineParts]() -> bool {
+          ScriptCommand::waitUntil([=, &vineParts]() -> bool {
              return vineParts.front()->getComponent<PositionComponent>()->getTop() <=
                     (vineComponent->teleportCoordinates.y * SCALED_CUBE_SIZE) -
                         (SCALED_CUBE_SIZE * 4);
           }),
-          new RunCommand([=, &vineParts]() {
+          ScriptCommand::run([=, &vineParts]() {
              for (Entity* vinePiece : vineParts) {
                 vinePiece->getComponent<MovingComponent>()->velocity.y = 0.0;
                 vinePiece->remove<VineComponent>();
              }
           }),
           /* Wait until the player has climbed to the top of the vine, then end the sequence */
-          new WaitUntilCommand([=, &vineParts]() -> bool {
+          ScriptCommand::waitUntil([=, &vineParts]() -> bool {
              return playerPosition->getBottom() <=
                     vineParts[1]->getComponent<PositionComponent>()->getBottom();
           }),
-          new RunCommand([=, &vineParts]() {
+          ScriptCommand::run([=, &vineParts]() {
              // Moves the player away from the vine
              playerPosition->setLeft(
                  vineParts.front()->getComponent<PositionComponent>()->getRight());
@@ -97,14 +95,6 @@ class VineCommand : public SequenceCommand {
              WarpSystem::setClimbing(false);
 
              WarpSystem::setClimbed(true);
-          })});
-   }
-
-   void execute() override {
-      SequenceCommand::execute();
-   }
-
-   bool isFinished() override {
-      return SequenceCommand::isFinished();
+          }));
    }
 };
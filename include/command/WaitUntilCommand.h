@@ -1,11 +1,11 @@
 #pragma once
 
 #include "command/Command.h"
-#include "util/Supplier.h"
+#include "util/InlineFunction.h"
 
 class WaitUntilCommand : public Command {
   public:
-   WaitUntilCommand(BooleanSupplier condition) : condition{condition} {}
+   WaitUntilCommand(InlineFunction<bool()> condition) : condition{std::move(condition)} {}
 
    void execute() override {}
 
@@ -14,5 +14,5 @@ class WaitUntilCommand : public Command {
    }
 
   private:
-   BooleanSupplier condition;
+   InlineFunction<bool()> condition;
 };
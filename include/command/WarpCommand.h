@@ -1,24 +1,22 @@
 #pragma once
 
+#include "AudioQueue.h"
 #include "Camera.h"
 #include "ECS/ECS.h"
 #include "SMBMath.h"
 #include "command/Command.h"
-#include "command/RunCommand.h"
-#include "command/SequenceCommand.h"
-#include "command/WaitCommand.h"
-#include "command/WaitUntilCommand.h"
+#include "command/ScriptCommand.h"
 #include "scenes/GameScene.h"
 #include "systems/PlayerSystem.h"
 #include "systems/WarpSystem.h"
 
 #include <vector>
 
-class WarpCommand : public SequenceCommand {
+class WarpCommand : public ScriptCommand {
   public:
    WarpCommand(GameScene* scene, World* world, Entity* pipe, Entity* player) {
       if (player->hasAny<ParticleComponent, DeadComponent>()) {
-         addCommands(std::vector<Command*>{new RunCommand([]() {})});
+         addSteps(ScriptCommand::run([]() {}));
          return;
       }
 
@@ -37,15 +35,14 @@ class WarpCommand : public SequenceCommand {
 
       scene->stopMusic();
 
-      Entity* pipeSound(world->create());
-      pipeSound->addComponent<SoundComponent>(SoundID::PIPE);
+      AudioQueue::Get().playSound(SoundID::PIPE);
 
       player->addComponent<CollisionExemptComponent>();
       player->addComponent<FrictionExemptComponent>();
       player->remove<GravityComponent>();
 
-      addCommands(std::vector<Command*>{
-          new RunCommand([=]() {
+      addSteps(
+          ScriptCommand::run([=]() {
              // Set the player's speed to go in the pipe
              switch (warpPipe->inDirection) {
                 case Direction::UP:
@@ -73,7 +70,7 @@ class WarpCommand : public SequenceCommand {
              }
           }),
           /* Enter the pipe */
-          new WaitUntilCommand([=]() -> bool {
+          ScriptCommand::waitUntil([=]() -> bool {
              switch (warpPipe->inDirection) {
                 case Direction::UP:
                    return player->getComponent<PositionComponent>()->getBottom() <
@@ -96,7 +93,7 @@ class WarpCommand : public SequenceCommand {
              }
           }),
           /* Teleport or go to new level */
-          new RunCommand([=]() {
+          ScriptCommand::run([=]() {
              if (warpPipe->newLevel != Vector2i(0, 0)) {
                 Camera::Get().setCameraFrozen(false);
 
@@ -174,11 +171,11 @@ class WarpCommand : public SequenceCommand {
                 default:
                    break;
              }
-          })});
+          }));
       // Extra commands to add on if the pipe doesn't lead to a new level
       if (warpPipe->newLevel == Vector2i(0, 0)) {
-         addCommands(std::vector<Command*>{
-             new WaitUntilCommand([=]() -> bool {
+         addSteps(
+             ScriptCommand::waitUntil([=]() -> bool {
                 switch (warpPipe->outDirection) {
                    case Direction::UP:
                       return playerPosition->getBottom() < teleportLocation.y * SCALED_CUBE_SIZE;
@@ -197,7 +194,7 @@ class WarpCommand : public SequenceCommand {
                       break;
                 }
              }),
-             new RunCommand([=]() {
+             ScriptCommand::run([=]() {
                 WarpSystem::setWarping(false);
                 PlayerSystem::enableInput(true);
                 PlayerSystem::setGameStart(false);
@@ -208,18 +205,10 @@ class WarpCommand : public SequenceCommand {
                 player->addComponent<GravityComponent>();
                 player->remove<CollisionExemptComponent>();
                 player->remove<FrictionExemptComponent>();
-             })});
+             }));
       }
    }
 
-   void execute() override {
-      SequenceCommand::execute();
-   }
-
-   bool isFinished() override {
-      return SequenceCommand::isFinished();
-   }
-
   private:
    Vector2<float> toVector2f(Vector2i vector) {
       return Vector2f((float)vector.x, (float)vector.y);
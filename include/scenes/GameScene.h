@@ -1,12 +1,13 @@
 #pragma once
 
 #include "Level.h"
+#include "LevelLoader.h"
+#include "LevelPrefetcher.h"
 #include "Map.h"
 #include "Scene.h"
 #include "systems/RenderSystem.h"
 #include "systems/Systems.h"
-
-#include <SDL2/SDL_thread.h>
+#include "util/InlineFunction.h"
 
 #include <functional>
 #include <memory>
@@ -58,6 +59,10 @@ class GameScene : public Scene {
 
    void setupLevel();
 
+   // Ends every transition screen after the same number of ticks, waiting for the level loader
+   // then if it isn't done yet. Used when a run has to play out the same way every time
+   static void setFixedTransitions(bool fixed);
+
    void switchLevel(int level, int subLevel);
    void restartLevel();
 
@@ -92,11 +97,21 @@ class GameScene : public Scene {
   private:
    friend class MapSystem;
 
+   static bool fixedTransitions;
+
    void pause();
 
    void unpause();
 
-   SDL_Thread* loaderThread;
+   LevelLoader levelLoader;
+   LevelPrefetcher levelPrefetcher;
+
+   // Whether the last loadLevel() found the level in the cache and how long it took, for the
+   // report that setupLevel() prints. A level that was loaded isn't loaded again by setupLevel()
+   std::shared_ptr<const PreparedLevel> lastLoadedLevel;
+   bool lastLoadCached = false;
+   double lastLoadMilliseconds = 0.0;
+   bool levelLoaded = false;
 
    PlayerSystem* playerSystem;
    MapSystem* mapSystem;
@@ -129,7 +144,7 @@ class GameScene : public Scene {
    Map aboveForegroundMap;
    Map collectiblesMap;
 
-   std::vector<std::function<void(void)>> commandQueue;
+   std::vector<InlineFunction<void(void)>> commandQueue;
 
    bool gameFinished = false;
    bool gameWon = false;
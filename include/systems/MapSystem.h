@@ -3,8 +3,10 @@
 #include "ECS/ECS.h"
 #include "scenes/GameScene.h"
 
+#include <cstdint>
 #include <memory>
 #include <tuple>
+#include <vector>
 
 class GameScene;
 
@@ -12,23 +14,58 @@ class MapSystem : public System {
   public:
    MapSystem(GameScene* scene);
 
-   void tick(World* world) override{};
+   // Creates and retires the streamed columns around the camera
+   void tick(World* world) override;
 
-   void loadEntities();
+   // Creates the level's entities, this runs on the LevelLoader's thread
    void loadEntities(World* world);
    void hideGameEntities(World* world);
    void showGameEntities(World* world);
 
+   // When streaming is enabled, only the columns of the level around the camera have entities
+   static void setStreamingEnabled(bool enabled);
+
+   // Streams columns while the level is being played, stopping also forgets the streamed columns
+   void setStreamingActive(bool active);
+
   private:
+   enum class ColumnState : uint8_t
+   {
+      UNLOADED,
+      LOADED,
+      RETIRED  // Only the blocks and enemies that were created the first time are left
+   };
+
+   // How many columns past the right of the camera are created, and how far a column has to be
+   // behind the camera's minimum X before its plain blocks are destroyed
+   static constexpr int STREAM_AHEAD_COLUMNS = 4;
+   static constexpr int RETIRE_BEHIND_COLUMNS = 2;
+
+   static bool streamingEnabled;
+
    GameScene* scene;
 
+   bool streamingActive = false;
+   std::vector<ColumnState> columnStates;
+   std::vector<std::vector<Entity*>> columnScenery;  // The plain blocks of each column
+   int lowestLoadedColumn = 0;
+
+   void loadAllEntities(World* world);
+
+   void spawnColumns(World* world, int firstColumn, int lastColumn);
+   void spawnColumn(World* world, int column, bool plainBlocksOnly);
+   void retireColumn(World* world, int column);
+
+   static bool isPlainBlock(int referenceID);
+   static bool isEnemyPart(int entityID);
+
    Entity* createBlockEntity(World* world, int coordinateX, int coordinateY, int entityID);
    Entity* createBackgroundEntity(World* world, int coordinateX, int coordinateY, int entityID);
-   Entity* createPlatformEntity(
-       World* world, int coordinateX, int coordinateY, int entityID, int platformLength,
-       std::tuple<PlatformMotionType, Direction, Vector2i, bool> platformData);
-   Entity* createPlatformLevelEntity(World* world,
-                                     std::tuple<Vector2i, Vector2i, int> platformLevelData);
+   Entity* createAboveForegroundEntity(World* world, int coordinateX, int coordinateY,
+                                       int entityID);
+   Entity* createPlatformEntity(World* world, int coordinateX, int coordinateY, int entityID,
+                                int platformLength, const MovingPlatformData& platformData);
+   Entity* createPlatformLevelEntity(World* world, const PlatformLevelData& platformLevelData);
 
    float generateRandomNumber(float min, float max);
 
@@ -47,4 +84,11 @@ class MapSystem : public System {
                             int referenceID);
 
    void createFireBarEntities(World* world);
+   void createFireBarEntity(World* world, const FireBarData& fireBarData);
+
+   void createAboveForegroundEntities(World* world, int coordinateX, int coordinateY, int entityID,
+                                      int referenceID);
+
+   // Looks up what every block in the collectibles layer dispenses, before the blocks are created
+   void indexMysteryBoxes();
 };
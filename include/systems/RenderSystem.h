@@ -1,9 +1,14 @@
 #pragma once
 
 #include "ECS/ECS.h"
+#include "RenderSnapshot.h"
 
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_ttf.h>
+
+/*
+ * The RenderSystem doesn't draw anything itself, it records what is visible this frame into a
+ * RenderSnapshot, which the TextureManager draws on the render thread.
+ * */
 
 class RenderSystem : public System {
   public:
@@ -11,8 +16,6 @@ class RenderSystem : public System {
 
    ~RenderSystem() override = default;
 
-   void onAddedToWorld(World* world) override;
-
    void tick(World* world) override;
 
    void handleInput(SDL_Event& event) override {}
@@ -26,12 +29,9 @@ class RenderSystem : public System {
    }
 
   private:
-   void renderEntity(Entity* entity, bool cameraBound = true);
+   void renderEntity(RenderSnapshot& snapshot, Entity* entity, bool cameraBound = true);
 
-   void renderText(Entity* entity, bool followCamera = false);
+   void renderText(RenderSnapshot& snapshot, Entity* entity, bool followCamera = false);
 
    bool transitionRendering = false;
-
-   std::shared_ptr<TTF_Font> normalFont;
-   std::shared_ptr<TTF_Font> smallFont;
 };
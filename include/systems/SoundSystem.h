@@ -4,5 +4,7 @@
 
 class SoundSystem : public System {
   public:
+   void onAddedToWorld(World* world) override;
+
    void tick(World* world) override;
 };
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/*
+ * An InlineFunction stores a callable, usually a lambda, inside of itself instead of on the heap
+ * like std::function can. The capture has to fit in the capacity, which is checked when the code
+ * is compiled, and there is no heap fallback. It can be moved but not copied, so a capture is
+ * never duplicated by accident.
+ *
+ * The default capacity can be changed with -DINLINE_FUNCTION_CAPACITY=<bytes>.
+ * */
+
+#ifndef INLINE_FUNCTION_CAPACITY
+#define INLINE_FUNCTION_CAPACITY 64
+#endif
+
+template <typename Signature, std::size_t Capacity = INLINE_FUNCTION_CAPACITY>
+class InlineFunction;
+
+template <typename Result, typename... Args, std::size_t Capacity>
+class InlineFunction<Result(Args...), Capacity> {
+  public:
+   InlineFunction() = default;
+
+   InlineFunction(std::nullptr_t) {}
+
+   template <typename Function,
+             typename = std::enable_if_t<!std::is_same_v<std::decay_t<Function>, InlineFunction>>>
+   InlineFunction(Function&& function) {
+      using Callable = std::decay_t<Function>;
+
+      static_assert(sizeof(Callable) <= Capacity,
+                    "The capture is too large for this InlineFunction, capture less or give it a "
+                    "larger capacity");
+      static_assert(alignof(Callable) <= alignof(std::max_align_t),
+                    "The capture needs a larger alignment than an InlineFunction has");
+      static_assert(std::is_invocable_r_v<Result, Callable&, Args...>,
+                    "The function can't be called with the arguments of this InlineFunction");
+
+      new (storage) Callable(std::forward<Function>(function));
+
+      invoker = [](void* callable, Args... arguments) -> Result {
+         return (*static_cast<Callable*>(callable))(std::forward<Args>(arguments)...);
+      };
+      manager = [](void* destination, void* source) {
+         if (destination != nullptr) {
+            new (destination) Callable(std::move(*static_cast<Callable*>(source)));
+         }
+         static_cast<Callable*>(source)->~Callable();
+      };
+   }
+
+   InlineFunction(InlineFunction&& other) noexcept {
+      moveFrom(other);
+   }
+
+   InlineFunction& operator=(InlineFunction&& other) noexcept {
+      if (this != &other) {
+         reset();
+         moveFrom(other);
+      }
+      return *this;
+   }
+
+   InlineFunction(const InlineFunction&) = delete;
+   InlineFunction& operator=(const InlineFunction&) = delete;
+
+   ~InlineFunction() {
+      reset();
+   }
+
+   Result operator()(Args... arguments) const {
+      assert(invoker && "Calling an empty InlineFunction.");
+
+      return invoker(storage, std::forward<Args>(arguments)...);
+   }
+
+   explicit operator bool() const {
+      return invoker != nullptr;
+   }
+
+  private:
+   // Moves the callable out of other, which is left empty
+   void moveFrom(InlineFunction& other) {
+      if (!other.invoker) {
+         return;
+      }
+
+      other.manager(storage, other.storage);
+
+      invoker = other.invoker;
+      manager = other.manager;
+
+      other.invoker = nullptr;
+      other.manager = nullptr;
+   }
+
+   void reset() {
+      if (manager) {
+         manager(nullptr, storage);
+      }
+
+      invoker = nullptr;
+      manager = nullptr;
+   }
+
+   alignas(std::max_align_t) mutable unsigned char storage[Capacity];
+
+   Result (*invoker)(void*, Args...) = nullptr;
+
+   // Moves the callable from the source into the destination and destroys the source, or only
+   // destroys the source if there is no destination
+   void (*manager)(void*, void*) = nullptr;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/*
+ * A read only file mapped into memory. The contents are paged in by the OS as they are used
+ * instead of being read into a buffer up front.
+ * */
+
+class MappedFile {
+  public:
+   MappedFile() = default;
+
+   ~MappedFile();
+
+   // Returns false if the file doesn't exist, is empty, or couldn't be mapped
+   bool open(const std::string& path);
+
+   void close();
+
+   bool isOpen() const {
+      return mappedData != nullptr;
+   }
+
+   const unsigned char* data() const {
+      return mappedData;
+   }
+
+   std::size_t size() const {
+      return mappedSize;
+   }
+
+  private:
+   MappedFile(const MappedFile&) = delete;
+   MappedFile& operator=(const MappedFile&) = delete;
+
+   const unsigned char* mappedData = nullptr;
+   std::size_t mappedSize = 0;
+
+#ifdef _WIN32
+   void* fileHandle = nullptr;
+   void* mappingHandle = nullptr;
+#endif
+};
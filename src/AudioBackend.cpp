@@ -0,0 +1,126 @@
+#include "AudioBackend.h"
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+std::unique_ptr<AudioBackend> AudioBackend::create(AudioBackendType type,
+                                                   const std::string& capturePath) {
+   switch (type) {
+      case AudioBackendType::NONE:
+         return std::make_unique<NullAudioBackend>();
+      case AudioBackendType::CAPTURE:
+         return std::make_unique<CaptureAudioBackend>(capturePath);
+      default:
+         return std::make_unique<MixerAudioBackend>();
+   }
+}
+
+int MixerAudioBackend::open(int channelCount) {
+   if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 4, 1024) != 0) {
+      SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Failed to Open Audio: %s", SDL_GetError());
+      std::cerr << "Failed to Open Audio: " << SDL_GetError() << std::endl;
+      return -1;
+   }
+
+   // The mixer's channels are the voices that can play at once, the 4 above are speakers
+   return Mix_AllocateChannels(channelCount);
+}
+
+void MixerAudioBackend::close() {
+   Mix_CloseAudio();
+   Mix_Quit();
+}
+
+AudioData MixerAudioBackend::loadSound(const char* path) {
+   std::shared_ptr<Mix_Chunk> chunk(Mix_LoadWAV(path), Mix_FreeChunk);
+   if (!chunk) {
+      return {};
+   }
+
+   return AudioData{chunk, chunk->alen};
+}
+
+// Music is streamed from its file while it plays, so the size of the file is what it can take up
+AudioData MixerAudioBackend::loadMusic(const char* path) {
+   std::shared_ptr<Mix_Music> music(Mix_LoadMUS(path), Mix_FreeMusic);
+   if (!music) {
+      return {};
+   }
+
+   std::error_code error;
+   std::uintmax_t size = std::filesystem::file_size(path, error);
+
+   return AudioData{music, error ? 0 : (std::size_t)size};
+}
+
+const char* MixerAudioBackend::getError() const {
+   return Mix_GetError();
+}
+
+bool MixerAudioBackend::playSound(int channel, const AudioData& sound) {
+   return Mix_PlayChannel(channel, static_cast<Mix_Chunk*>(sound.data.get()), 0) >= 0;
+}
+
+bool MixerAudioBackend::isPlaying(int channel) const {
+   return Mix_Playing(channel) != 0;
+}
+
+void MixerAudioBackend::haltSound(int channel) {
+   Mix_HaltChannel(channel);
+}
+
+void MixerAudioBackend::pauseSounds() {
+   Mix_Pause(-1);
+}
+
+void MixerAudioBackend::resumeSounds() {
+   Mix_Resume(-1);
+}
+
+bool MixerAudioBackend::playMusic(const AudioData& music) {
+   return Mix_PlayMusic(static_cast<Mix_Music*>(music.data.get()), -1) == 0;
+}
+
+void MixerAudioBackend::haltMusic() {
+   Mix_HaltMusic();
+}
+
+void MixerAudioBackend::pauseMusic() {
+   Mix_PauseMusic();
+}
+
+void MixerAudioBackend::resumeMusic() {
+   Mix_ResumeMusic();
+}
+
+// Nothing is decoded, but a missing file still fails like it would with the mixer
+AudioData NullAudioBackend::loadSound(const char* path) {
+   if (!std::filesystem::exists(path)) {
+      return {};
+   }
+
+   return AudioData{std::make_shared<char>(0), 0};
+}
+
+AudioData NullAudioBackend::loadMusic(const char* path) {
+   return loadSound(path);
+}
+
+bool NullAudioBackend::playSound(int channel, const AudioData& sound) {
+   soundCount++;
+   return true;
+}
+
+bool NullAudioBackend::playMusic(const AudioData& music) {
+   musicCount++;
+   return true;
+}
+
+void NullAudioBackend::printReport() {
+   std::cout << "Null audio: " << soundCount << " sounds and " << musicCount
+             << " music started over " << tick << " ticks" << std::endl;
+}
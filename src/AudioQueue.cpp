@@ -0,0 +1,58 @@
+#include "AudioQueue.h"
+
+AudioQueue AudioQueue::instance;
+
+void AudioQueue::playSound(SoundID sound) {
+   if (queuedSounds[(std::size_t)sound]) {
+      mergedCount++;
+      return;
+   }
+
+   AudioEvent event;
+   event.type = AudioEventType::SOUND;
+   event.sound = sound;
+
+   push(event);
+}
+
+void AudioQueue::playMusic(MusicID music) {
+   AudioEvent event;
+   event.type = AudioEventType::MUSIC;
+   event.music = music;
+
+   push(event);
+}
+
+bool AudioQueue::pop(AudioEvent& event) {
+   if (head == tail) {
+      return false;
+   }
+
+   event = events[head & (CAPACITY - 1)];
+   head++;
+
+   if (event.type == AudioEventType::SOUND) {
+      queuedSounds[(std::size_t)event.sound] = false;
+   }
+
+   return true;
+}
+
+void AudioQueue::clear() {
+   head = tail = 0;
+   queuedSounds.reset();
+}
+
+void AudioQueue::push(const AudioEvent& event) {
+   if (tail - head == CAPACITY) {
+      droppedCount++;
+      return;
+   }
+
+   events[tail & (CAPACITY - 1)] = event;
+   tail++;
+
+   if (event.type == AudioEventType::SOUND) {
+      queuedSounds[(std::size_t)event.sound] = true;
+   }
+}
@@ -6,7 +6,7 @@
 Camera Camera::m_instance;
 
 void Camera::setCameraX(float x) {
-   m_cameraX = x;
+   moveCameraX(x);
 }
 
 void Camera::setCameraY(float y) {
@@ -14,7 +14,7 @@ void Camera::setCameraY(float y) {
 }
 
 void Camera::increaseCameraX(float value) {
-   m_cameraX += value;
+   moveCameraX(m_cameraX + value);
 }
 
 void Camera::updateCameraMin() {
@@ -90,3 +90,10 @@ bool Camera::inCameraYRange(PositionComponent* position) {
    return position->position.y + position->scale.y >= getCameraY() &&
           position->position.y <= getCameraY() + SCREEN_HEIGHT;
 }
+
+void Camera::moveCameraX(float x) {
+   if (x != m_cameraX) {
+      EventBus::Get().publish(CameraPassedXEvent{m_cameraX, x});
+   }
+   m_cameraX = x;
+}
@@ -0,0 +1,252 @@
+#include "AudioBackend.h"
+
+#include "Constants.h"
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+constexpr int FRAMES_PER_TICK = CaptureAudioBackend::SAMPLE_RATE / MAX_FPS;
+constexpr int BYTES_PER_SAMPLE = 2;
+
+void writeLittleEndian(std::ostream& stream, uint32_t value, int bytes) {
+   for (int i = 0; i < bytes; i++) {
+      stream.put((char)((value >> (8 * i)) & 0xFF));
+   }
+}
+
+}  // namespace
+
+CaptureAudioBackend::~CaptureAudioBackend() {
+   close();
+}
+
+int CaptureAudioBackend::open(int channelCount) {
+   file.open(path, std::ios::binary | std::ios::trunc);
+   if (!file) {
+      std::cerr << "Failed to Open Audio Capture " << path << std::endl;
+      return -1;
+   }
+
+   log.open(path + ".log", std::ios::trunc);
+   if (!log) {
+      std::cerr << "Failed to Open Audio Capture Log " << path << ".log" << std::endl;
+      return -1;
+   }
+
+   // The sizes in the header are filled in when the capture is closed
+   writeHeader();
+
+   voices.resize(channelCount);
+   mix.resize(FRAMES_PER_TICK * SPEAKERS);
+   frameBytes.resize(mix.size() * BYTES_PER_SAMPLE);
+
+   return channelCount;
+}
+
+void CaptureAudioBackend::close() {
+   if (!file.is_open()) {
+      return;
+   }
+
+   file.seekp(0);
+   writeHeader();
+   file.close();
+
+   log.close();
+
+   voices.clear();
+   music = Voice{};
+}
+
+void CaptureAudioBackend::writeHeader() {
+   uint32_t dataBytes = (uint32_t)(sampleCount * SPEAKERS * BYTES_PER_SAMPLE);
+
+   file.write("RIFF", 4);
+   writeLittleEndian(file, 36 + dataBytes, 4);
+   file.write("WAVEfmt ", 8);
+   writeLittleEndian(file, 16, 4);  // Size of the format
+   writeLittleEndian(file, 1, 2);   // PCM
+   writeLittleEndian(file, SPEAKERS, 2);
+   writeLittleEndian(file, SAMPLE_RATE, 4);
+   writeLittleEndian(file, SAMPLE_RATE * SPEAKERS * BYTES_PER_SAMPLE, 4);
+   writeLittleEndian(file, SPEAKERS * BYTES_PER_SAMPLE, 2);
+   writeLittleEndian(file, BYTES_PER_SAMPLE * 8, 2);
+   file.write("data", 4);
+   writeLittleEndian(file, dataBytes, 4);
+}
+
+// Sounds and music are both decoded completely, since music is mixed the same way as a sound
+AudioData CaptureAudioBackend::loadClip(const char* path) {
+   SDL_AudioSpec spec;
+   Uint8* buffer = nullptr;
+   Uint32 length = 0;
+
+   if (!SDL_LoadWAV(path, &spec, &buffer, &length)) {
+      return {};
+   }
+
+   SDL_AudioCVT converter;
+   if (SDL_BuildAudioCVT(&converter, spec.format, spec.channels, spec.freq, AUDIO_S16SYS,
+                         SPEAKERS, SAMPLE_RATE) < 0) {
+      SDL_FreeWAV(buffer);
+      return {};
+   }
+
+   // The conversion is done in place, in a buffer that is large enough for the result
+   std::vector<Uint8> converted((std::size_t)length * std::max(converter.len_mult, 1));
+   std::memcpy(converted.data(), buffer, length);
+   SDL_FreeWAV(buffer);
+
+   std::size_t convertedLength = length;
+
+   if (converter.needed) {
+      converter.buf = converted.data();
+      converter.len = (int)length;
+
+      if (SDL_ConvertAudio(&converter) != 0) {
+         return {};
+      }
+      convertedLength = converter.len_cvt;
+   }
+
+   auto clip = std::make_shared<Clip>();
+   clip->path = path;
+   clip->samples.resize(convertedLength / BYTES_PER_SAMPLE / SPEAKERS * SPEAKERS);
+   std::memcpy(clip->samples.data(), converted.data(), clip->samples.size() * BYTES_PER_SAMPLE);
+
+   return AudioData{clip, clip->samples.size() * BYTES_PER_SAMPLE};
+}
+
+AudioData CaptureAudioBackend::loadSound(const char* path) {
+   return loadClip(path);
+}
+
+AudioData CaptureAudioBackend::loadMusic(const char* path) {
+   return loadClip(path);
+}
+
+const char* CaptureAudioBackend::getError() const {
+   return SDL_GetError();
+}
+
+bool CaptureAudioBackend::playSound(int channel, const AudioData& sound) {
+   if (channel < 0 || channel >= (int)voices.size()) {
+      return false;
+   }
+
+   voices[channel] = Voice{std::static_pointer_cast<const Clip>(sound.data)};
+   soundCount++;
+
+   log << tick << " sound " << channel << " " << voices[channel].clip->path << '\n';
+
+   return true;
+}
+
+bool CaptureAudioBackend::isPlaying(int channel) const {
+   return voices[channel].clip != nullptr;
+}
+
+void CaptureAudioBackend::haltSound(int channel) {
+   voices[channel] = Voice{};
+}
+
+void CaptureAudioBackend::pauseSounds() {
+   for (Voice& voice : voices) {
+      voice.paused = true;
+   }
+}
+
+void CaptureAudioBackend::resumeSounds() {
+   for (Voice& voice : voices) {
+      voice.paused = false;
+   }
+}
+
+bool CaptureAudioBackend::playMusic(const AudioData& data) {
+   music = Voice{std::static_pointer_cast<const Clip>(data.data)};
+   musicCount++;
+
+   log << tick << " music " << music.clip->path << '\n';
+
+   return true;
+}
+
+void CaptureAudioBackend::haltMusic() {
+   music = Voice{};
+}
+
+void CaptureAudioBackend::pauseMusic() {
+   music.paused = true;
+}
+
+void CaptureAudioBackend::resumeMusic() {
+   music.paused = false;
+}
+
+bool CaptureAudioBackend::mixVoice(Voice& voice, std::vector<int32_t>& mix, bool loop) {
+   const std::vector<int16_t>& samples = voice.clip->samples;
+   if (samples.empty()) {
+      return false;
+   }
+
+   for (int32_t& sample : mix) {
+      if (voice.position >= samples.size()) {
+         if (!loop) {
+            return false;
+         }
+         voice.position = 0;
+      }
+      sample += samples[voice.position++];
+   }
+
+   return loop || voice.position < samples.size();
+}
+
+void CaptureAudioBackend::advanceTick() {
+   if (!file.is_open()) {
+      return;
+   }
+
+   std::fill(mix.begin(), mix.end(), 0);
+
+   for (Voice& voice : voices) {
+      if (voice.clip && !voice.paused && !mixVoice(voice, mix, false)) {
+         voice = Voice{};  // Frees the channel, like the mixer does when a sound ends
+      }
+   }
+   if (music.clip && !music.paused) {
+      mixVoice(music, mix, true);
+   }
+
+   // Written as little endian, which is what WAV files use on every machine
+   for (std::size_t i = 0; i < mix.size(); i++) {
+      int32_t sample = mix[i];
+
+      if (sample > std::numeric_limits<int16_t>::max() ||
+          sample < std::numeric_limits<int16_t>::min()) {
+         sample = std::clamp<int32_t>(sample, std::numeric_limits<int16_t>::min(),
+                                      std::numeric_limits<int16_t>::max());
+         clippedCount++;
+      }
+
+      frameBytes[i * BYTES_PER_SAMPLE] = (char)(sample & 0xFF);
+      frameBytes[i * BYTES_PER_SAMPLE + 1] = (char)((sample >> 8) & 0xFF);
+   }
+
+   file.write(frameBytes.data(), frameBytes.size());
+
+   sampleCount += FRAMES_PER_TICK;
+   tick++;
+}
+
+void CaptureAudioBackend::printReport() {
+   std::cout << "Captured " << (double)sampleCount / SAMPLE_RATE << " s of audio to " << path
+             << ": " << soundCount << " sounds and " << musicCount << " music started, "
+             << clippedCount << " samples clipped" << std::endl;
+}
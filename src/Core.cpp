@@ -1,15 +1,46 @@
 #include "Core.h"
 
+#include "AudioQueue.h"
 #include "Constants.h"
+#include "EventBus.h"
 #include "SoundManager.h"
 #include "TextureManager.h"
 #include "command/CommandScheduler.h"
+#include "scenes/GameScene.h"
+#include "systems/MapSystem.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <stdlib.h>
+#include <string>
+#include <thread>
+#include <utility>
 
-Core::Core() {
-   game = Game(this);
+namespace {
+
+// Reads the number that follows an option. A value that isn't a whole number is reported like an
+// unknown argument, and the option keeps its default
+bool parseNumber(const char* option, const char* text, int& value) {
+   const char* end = text + strlen(text);
+
+   int number = 0;
+   auto [next, error] = std::from_chars(text, end, number);
+
+   if (error != std::errc() || next == text || next != end) {
+      std::cerr << "Unknown Argument: " << option << " " << text << std::endl;
+      return false;
+   }
+
+   value = number;
+   return true;
+}
+
+}  // namespace
+
+Core::Core() : game(this) {
    running = true;
 }
 
@@ -19,35 +50,218 @@ void Core::limitFPS(Uint64 startTick) {
    }
 }
 
+void Core::parseArguments(int argc, char** argv) {
+   for (int i = 1; i < argc; i++) {
+      if (strcmp(argv[i], "--headless") == 0) {
+         options.headless = true;
+      } else if (strcmp(argv[i], "--low-res") == 0) {
+         options.lowResolution = true;
+      } else if (strcmp(argv[i], "--stream-entities") == 0) {
+         options.streamEntities = true;
+      } else if (strcmp(argv[i], "--single-thread") == 0) {
+         options.singleThreaded = true;
+      } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+         i++;
+         parseNumber(argv[i - 1], argv[i], options.frameLimit);
+      } else if (strcmp(argv[i], "--sound-channels") == 0 && i + 1 < argc) {
+         i++;
+         parseNumber(argv[i - 1], argv[i], options.soundChannels);
+      } else if (strcmp(argv[i], "--music-budget") == 0 && i + 1 < argc) {
+         i++;
+         int megabytes = 0;
+         if (parseNumber(argv[i - 1], argv[i], megabytes)) {
+            options.musicBudget = (std::size_t)std::max(megabytes, 0) * 1024 * 1024;
+         }
+      } else if (strcmp(argv[i], "--null-audio") == 0) {
+         options.audioBackend = AudioBackendType::NONE;
+      } else if (strcmp(argv[i], "--capture-audio") == 0 && i + 1 < argc) {
+         options.audioBackend = AudioBackendType::CAPTURE;
+         options.audioCapturePath = argv[++i];
+      } else if (strcmp(argv[i], "--record-input") == 0 && i + 1 < argc) {
+         options.inputRecordPath = argv[++i];
+      } else if (strcmp(argv[i], "--play-input") == 0 && i + 1 < argc) {
+         options.inputPlaybackPath = argv[++i];
+      } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+         i++;
+         parseNumber(argv[i - 1], argv[i], options.seed);
+      } else if (strcmp(argv[i], "--capture-png") == 0 && i + 1 < argc) {
+         options.captureFormat = CaptureFormat::PNG;
+         options.capturePath = argv[++i];
+      } else if (strcmp(argv[i], "--capture-raw") == 0 && i + 1 < argc) {
+         options.captureFormat = CaptureFormat::RAW;
+         options.capturePath = argv[++i];
+      } else if (strcmp(argv[i], "--capture-interval") == 0 && i + 1 < argc) {
+         i++;
+         parseNumber(argv[i - 1], argv[i], options.captureInterval);
+      } else {
+         std::cerr << "Unknown Argument: " << argv[i] << std::endl;
+      }
+   }
+}
+
 int Core::init() {
-   if (TextureManager::Get().Init() != 0) {
+   if (TextureManager::Get().Init(options.headless, options.lowResolution) != 0) {
       std::cerr << "Error Initializing Texture Manager" << std::endl;
       return -1;
    }
-   if (SoundManager::Get().Init() != 0) {
+   std::unique_ptr<AudioBackend> audioBackend =
+       AudioBackend::create(options.audioBackend, options.audioCapturePath);
+
+   int soundResult = SoundManager::Get().Init(std::move(audioBackend), options.soundChannels,
+                                              options.musicBudget);
+
+   // Nobody listens to a headless run, so it goes on without sound if there is no audio device
+   if (soundResult != 0 && options.headless && options.audioBackend == AudioBackendType::MIXER) {
+      std::cerr << "Failed to Open Audio, falling back to the null audio backend" << std::endl;
+
+      soundResult = SoundManager::Get().Init(AudioBackend::create(AudioBackendType::NONE),
+                                             options.soundChannels, options.musicBudget);
+   }
+   if (soundResult != 0) {
       std::cerr << "Error Initializing Sound Manager" << std::endl;
       return -1;
    }
-   srand(time(NULL));  // Generates a random time seed for the game to generate random numbers
+   if (TextureManager::Get().StartCapture(options.captureFormat, options.capturePath,
+                                          options.captureInterval) != 0) {
+      std::cerr << "Error Starting Frame Capture" << std::endl;
+      return -1;
+   }
+   if (options.seed >= 0) {
+      srand(options.seed);  // A fixed seed makes runs repeatable, such as for frame captures
+   } else {
+      srand(time(NULL));  // Generates a random time seed for the game to generate random numbers
+   }
+   MapSystem::setStreamingEnabled(options.streamEntities);
+
+   // Runs that are compared with each other can't let the loader thread decide when a level starts
+   GameScene::setFixedTransitions(
+       options.headless || options.captureFormat != CaptureFormat::NONE ||
+       options.audioBackend == AudioBackendType::CAPTURE || !options.inputRecordPath.empty() ||
+       !options.inputPlaybackPath.empty());
+
    game.init();
+
+   if (!options.inputPlaybackPath.empty() &&
+       game.startInputPlayback(options.inputPlaybackPath) != 0) {
+      std::cerr << "Error Starting Input Playback" << std::endl;
+      return -1;
+   }
+   if (!options.inputRecordPath.empty() && game.startInputRecording(options.inputRecordPath) != 0) {
+      std::cerr << "Error Starting Input Recording" << std::endl;
+      return -1;
+   }
+
+   // Captures and headless runs need every simulated frame to be drawn, so they run in lockstep
+#ifndef __EMSCRIPTEN__
+   threaded = !options.singleThreaded && !options.headless &&
+              options.captureFormat == CaptureFormat::NONE;
+#endif
    return 0;
 }
 
 void Core::run() {
-   while (running) {
-      mainLoop();
+   Uint64 startTicks = SDL_GetTicks64();
+
+   if (threaded) {
+      runThreaded();
+   } else {
+      while (running) {
+         mainLoop();
+      }
    }
+
+   game.stopInputRecording();
+
+   if (options.headless) {
+      Uint64 elapsedTicks = SDL_GetTicks64() - startTicks;
+
+      std::cout << "Ran " << frameCount << " frames in " << elapsedTicks << " ms ("
+                << (frameCount > 0 ? (float)elapsedTicks / frameCount : 0.0f) << " ms per frame)"
+                << std::endl;
+
+      CommandPool& commandPool = CommandScheduler::getPool();
+      std::cout << "Commands: " << commandPool.getLiveCount() << " live, "
+                << commandPool.getPeakCount() << " at the peak" << std::endl;
+
+      SoundManager& soundManager = SoundManager::Get();
+      std::cout << "Sounds: " << soundManager.getDroppedCount() << " dropped, "
+                << soundManager.getStolenCount() << " cut off by a more important sound, "
+                << soundManager.getLimitedCount() << " left out while cooling down" << std::endl;
+      soundManager.printLoadReport();
+      soundManager.getBackend().printReport();
+
+      std::cout << "Audio events: " << AudioQueue::Get().getMergedCount()
+                << " merged into a sound on the same tick, " << AudioQueue::Get().getDroppedCount()
+                << " dropped" << std::endl;
+
+      // Handlers that are still waiting, per type of event
+      const char* separator = " ";
+      std::cout << "Event subscribers:";
+      for (auto& [name, count] : EventBus::Get().getSubscriberCounts()) {
+         std::cout << separator << name << " " << count;
+         separator = ", ";
+      }
+      std::cout << std::endl;
+   }
+
    TextureManager::Get().Quit();
    SoundManager::Get().Quit();
 }
 
+void Core::runThreaded() {
+   std::atomic<bool> simulationFinished = false;
+
+   std::thread simulationThread([this, &simulationFinished]() {
+      while (running) {
+         Uint64 startTicks = SDL_GetTicks64();
+         tick();
+         limitFPS(startTicks);
+      }
+      simulationFinished = true;
+   });
+
+   // The main thread owns the window and the renderer. It keeps running the render tasks until
+   // the simulation has stopped, since the simulation may be waiting on one of them
+   while (!simulationFinished) {
+      game.pollEvents();
+
+      TextureManager::Get().RunRenderTasks();
+
+      if (!TextureManager::Get().DrawLatestSnapshot()) {
+         SDL_Delay(1);
+      }
+   }
+
+   simulationThread.join();
+
+   TextureManager::Get().RunRenderTasks();
+}
+
 void Core::mainLoop() {
    Uint64 startTicks = SDL_GetTicks64();
+
+   game.pollEvents();
+   tick();
+   TextureManager::Get().DrawLatestSnapshot();
+
+   // Nothing is shown when running headless, so frames are simulated as fast as possible
+   if (!options.headless) {
+      limitFPS(startTicks);
+   }
+}
+
+void Core::tick() {
    game.handleInput();
    game.update();
    CommandScheduler::getInstance().run();
-   limitFPS(startTicks);
+
    std::cout << std::flush;
+
+   frameCount++;
+
+   if (options.frameLimit > 0 && frameCount >= options.frameLimit) {
+      running = false;
+   }
 }
 
 void Core::setRunning(bool val) {
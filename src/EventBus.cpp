@@ -0,0 +1,177 @@
+#include "EventBus.h"
+
+EventBus EventBus::instance;
+
+void EventBus::unsubscribe(SubscriptionID id) {
+   std::lock_guard<std::recursive_mutex> lock(mutex);
+
+   for (auto& channel : channels) {
+      if (channel && channel->remove(id)) {
+         return;
+      }
+   }
+}
+
+void EventBus::dispatch() {
+   std::lock_guard<std::recursive_mutex> lock(mutex);
+
+   // Indexed, since a handler can use an event type for the first time
+   for (std::size_t i = 0; i < channels.size(); i++) {
+      if (channels[i]) {
+         channels[i]->deliverQueued();
+      }
+   }
+}
+
+void EventBus::entityDestroyed(Entity* entity) {
+   std::lock_guard<std::recursive_mutex> lock(mutex);
+
+   getChannel<EntityDestroyedEvent>().deliverNow(EntityDestroyedEvent{entity});
+
+   for (auto& channel : channels) {
+      if (channel) {
+         channel->removeEntity(entity);
+         channel->forgetQueued(entity);
+      }
+   }
+}
+
+std::vector<std::pair<const char*, int>> EventBus::getSubscriberCounts() {
+   std::lock_guard<std::recursive_mutex> lock(mutex);
+
+   std::vector<std::pair<const char*, int>> counts;
+
+   for (auto& channel : channels) {
+      if (channel) {
+         counts.emplace_back(channel->getName(), channel->getSubscriberCount());
+      }
+   }
+
+   return counts;
+}
+
+void EventBus::Channel::add(Subscriber subscriber) {
+   if (subscriber.entity != nullptr) {
+      entityCounts[subscriber.entity]++;
+   } else {
+      globalCount++;
+   }
+   subscriberCount++;
+
+   if (deliverDepth > 0) {
+      added.push_back(std::move(subscriber));
+   } else {
+      subscribers.push_back(std::move(subscriber));
+   }
+}
+
+bool EventBus::Channel::remove(SubscriptionID id) {
+   for (std::size_t i = 0; i < subscribers.size(); i++) {
+      if (subscribers[i].id == id) {
+         removeAt(i);
+         return true;
+      }
+   }
+
+   for (std::size_t i = 0; i < added.size(); i++) {
+      if (added[i].id == id) {
+         Entity* entity = added[i].entity;
+
+         // Nothing is calling these yet, so they can be erased right away
+         added.erase(added.begin() + i);
+
+         if (entity != nullptr) {
+            if (--entityCounts[entity] == 0) {
+               entityCounts.erase(entity);
+            }
+         } else {
+            globalCount--;
+         }
+         subscriberCount--;
+
+         return true;
+      }
+   }
+
+   return false;
+}
+
+void EventBus::Channel::removeEntity(Entity* entity) {
+   if (entityCounts.count(entity) == 0) {
+      return;
+   }
+
+   for (std::size_t i = 0; i < subscribers.size(); i++) {
+      if (subscribers[i].id != 0 && subscribers[i].entity == entity) {
+         removeAt(i);
+      }
+   }
+
+   for (std::size_t i = added.size(); i > 0; i--) {
+      if (added[i - 1].entity == entity) {
+         remove(added[i - 1].id);
+      }
+   }
+}
+
+void EventBus::Channel::deliver(const void* event, Entity* entity) {
+   deliverDepth++;
+
+   for (std::size_t i = 0; i < subscribers.size(); i++) {
+      Subscriber& subscriber = subscribers[i];
+
+      if (subscriber.id == 0 || (subscriber.entity != nullptr && subscriber.entity != entity)) {
+         continue;
+      }
+
+      // The handler may have unsubscribed itself already
+      if (subscriber.handler(event) && subscriber.id != 0) {
+         removeAt(i);
+      }
+   }
+
+   deliverDepth--;
+
+   compact();
+}
+
+void EventBus::Channel::removeAt(std::size_t index) {
+   Subscriber& subscriber = subscribers[index];
+
+   if (subscriber.entity != nullptr) {
+      if (--entityCounts[subscriber.entity] == 0) {
+         entityCounts.erase(subscriber.entity);
+      }
+   } else {
+      globalCount--;
+   }
+   subscriberCount--;
+
+   // Only marked, the handler could be running right now
+   subscriber.id = 0;
+   hasRemoved = true;
+
+   if (deliverDepth == 0) {
+      compact();
+   }
+}
+
+void EventBus::Channel::compact() {
+   if (deliverDepth > 0) {
+      return;
+   }
+
+   if (hasRemoved) {
+      subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+                                       [](const Subscriber& subscriber) {
+                                          return subscriber.id == 0;
+                                       }),
+                        subscribers.end());
+      hasRemoved = false;
+   }
+
+   for (Subscriber& subscriber : added) {
+      subscribers.push_back(std::move(subscriber));
+   }
+   added.clear();
+}
@@ -0,0 +1,203 @@
+#include "FrameCapture.h"
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+FrameCapture::~FrameCapture() {
+   stop();
+}
+
+int FrameCapture::start(CaptureFormat format, const std::string& path, int interval, int width,
+                        int height) {
+   if (format == CaptureFormat::NONE || capturing) {
+      return 0;
+   }
+
+   this->format = format;
+   this->path = path;
+   this->interval = std::max(interval, 1);
+   this->width = width;
+   this->height = height;
+
+   if (format == CaptureFormat::RAW) {
+      if (path == "-") {
+#ifdef _WIN32
+         _setmode(_fileno(stdout), _O_BINARY);
+#endif
+         // Anything printed to std::cout would end up in the middle of the frame data
+         coutBuffer = std::cout.rdbuf(std::cerr.rdbuf());
+         rawStream = stdout;
+      } else {
+         rawStream = fopen(path.c_str(), "wb");
+      }
+
+      if (!rawStream) {
+         std::cerr << "Failed to Open Capture Stream: " << path << std::endl;
+         return -1;
+      }
+   } else {
+      std::error_code error;
+      std::filesystem::create_directories(path, error);
+
+      if (error) {
+         std::cerr << "Failed to Create Capture Directory: " << error.message() << std::endl;
+         return -1;
+      }
+   }
+
+   std::cerr << "Capturing every " << this->interval << " frame(s) at " << width << "x" << height
+             << " RGBA" << std::endl;
+
+   frameCounter = 0;
+   capturedFrames = 0;
+   stalledFrames = 0;
+   stopping = false;
+   capturing = true;
+
+   writerThread = std::thread(&FrameCapture::writeFrames, this);
+
+   return 0;
+}
+
+void FrameCapture::stop() {
+   if (!capturing) {
+      return;
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      stopping = true;
+   }
+   queueChanged.notify_all();
+
+   // The writer thread empties the queue before it exits
+   writerThread.join();
+
+   if (rawStream == stdout) {
+      fflush(stdout);
+      std::cout.rdbuf(coutBuffer);
+   } else if (rawStream) {
+      fclose(rawStream);
+   }
+   rawStream = nullptr;
+
+   freeBuffers.clear();
+   capturing = false;
+
+   std::cerr << "Captured " << capturedFrames << " frames (the game waited on the writer "
+             << stalledFrames << " times)" << std::endl;
+}
+
+void FrameCapture::captureFrame(SDL_Renderer* renderer) {
+   if (!capturing) {
+      return;
+   }
+
+   int frameNumber = frameCounter++;
+
+   if (frameNumber % interval != 0) {
+      return;
+   }
+
+   int outputWidth, outputHeight;
+   SDL_GetRendererOutputSize(renderer, &outputWidth, &outputHeight);
+
+   // Every frame in a capture has the same size, so frames after the window is resized are skipped
+   if (outputWidth != width || outputHeight != height) {
+      return;
+   }
+
+   std::vector<Uint8> pixels;
+   {
+      std::unique_lock<std::mutex> lock(queueMutex);
+
+      if (frameQueue.size() >= MAX_QUEUED_FRAMES) {
+         stalledFrames++;
+
+         queueChanged.wait(lock, [this]() {
+            return frameQueue.size() < MAX_QUEUED_FRAMES;
+         });
+      }
+
+      if (!freeBuffers.empty()) {
+         pixels = std::move(freeBuffers.back());
+         freeBuffers.pop_back();
+      }
+   }
+
+   pixels.resize((std::size_t)width * height * 4);
+
+   if (SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_RGBA32, pixels.data(),
+                            width * 4) != 0) {
+      std::cerr << "Failed to Read Frame " << frameNumber << ": " << SDL_GetError() << std::endl;
+      return;
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      frameQueue.push_back(Frame{frameNumber, std::move(pixels)});
+   }
+   queueChanged.notify_all();
+
+   capturedFrames++;
+}
+
+void FrameCapture::writeFrames() {
+   while (true) {
+      Frame frame;
+      {
+         std::unique_lock<std::mutex> lock(queueMutex);
+
+         queueChanged.wait(lock, [this]() {
+            return !frameQueue.empty() || stopping;
+         });
+
+         if (frameQueue.empty()) {
+            return;
+         }
+
+         frame = std::move(frameQueue.front());
+         frameQueue.pop_front();
+      }
+      // Lets the game loop know there is space in the queue again
+      queueChanged.notify_all();
+
+      writeFrame(frame);
+
+      std::lock_guard<std::mutex> lock(queueMutex);
+      freeBuffers.push_back(std::move(frame.pixels));
+   }
+}
+
+void FrameCapture::writeFrame(Frame& frame) {
+   switch (format) {
+      case CaptureFormat::PNG: {
+         SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(
+             frame.pixels.data(), width, height, 32, width * 4, SDL_PIXELFORMAT_RGBA32);
+
+         char fileName[32];
+         snprintf(fileName, sizeof(fileName), "frame_%06d.png", frame.frameNumber);
+
+         if (IMG_SavePNG(surface, (path + "/" + fileName).c_str()) != 0) {
+            std::cerr << "Failed to Save Frame " << frame.frameNumber << ": " << SDL_GetError()
+                      << std::endl;
+         }
+
+         SDL_FreeSurface(surface);
+      } break;
+      case CaptureFormat::RAW:
+         fwrite(frame.pixels.data(), 1, frame.pixels.size(), rawStream);
+         break;
+      default:
+         break;
+   }
+}
@@ -6,6 +6,8 @@
 
 #include <SDL2/SDL.h>
 
+#include <algorithm>
+
 Game::Game() {}
 
 Game::Game(Core* core) {
@@ -18,11 +20,8 @@ void Game::init() {
    scene = std::make_unique<MenuScene>();
 }
 
-void Game::handleInput() {
-   const Uint8* keystates = SDL_GetKeyboardState(nullptr);
-   Input::Get().update(keystates);
-
-   scene->handleInput();
+void Game::pollEvents() {
+   std::lock_guard<std::mutex> lock(inputMutex);
 
    SDL_Event event;
    while (SDL_PollEvent(&event)) {
@@ -31,12 +30,59 @@ void Game::handleInput() {
             core->setRunning(false);
             break;
          case SDL_KEYDOWN:
-            Input::Get().getCurrentRawKeys().push_back(event.key.keysym.scancode);
+            pressedRawKeys.push_back(event.key.keysym.scancode);
             break;
          default:
             break;
       }
    }
+
+   int keyCount;
+   const Uint8* keystates = SDL_GetKeyboardState(&keyCount);
+   std::copy(keystates, keystates + std::min<int>(keyCount, keyboardState.size()),
+             keyboardState.begin());
+}
+
+void Game::handleInput() {
+   std::array<Uint8, SDL_NUM_SCANCODES> keystates;
+   std::vector<SDL_Scancode> rawKeys;
+   {
+      std::lock_guard<std::mutex> lock(inputMutex);
+      keystates = keyboardState;
+      rawKeys.swap(pressedRawKeys);
+   }
+
+   if (inputPlayer.isPlaying()) {
+      KeySet keysDown;
+
+      if (!inputPlayer.next(keysDown)) {
+         core->setRunning(false);
+      }
+
+      // The keyboard is left out, so the replay gets exactly the input that was recorded
+      Input::Get().update(keysDown);
+   } else {
+      Input::Get().update(keystates.data());
+
+      std::vector<SDL_Scancode>& currentRawKeys = Input::Get().getCurrentRawKeys();
+      currentRawKeys.insert(currentRawKeys.end(), rawKeys.begin(), rawKeys.end());
+   }
+
+   inputRecorder.record(Input::Get().getKeysDown());
+
+   scene->handleInput();
+}
+
+int Game::startInputRecording(const std::string& path) {
+   return inputRecorder.start(path);
+}
+
+void Game::stopInputRecording() {
+   inputRecorder.stop();
+}
+
+int Game::startInputPlayback(const std::string& path) {
+   return inputPlayer.start(path);
 }
 
 void Game::update() {
@@ -3,67 +3,64 @@
 Input Input::instance;
 
 void Input::initDefault() {
-   keyBindings = std::unordered_map<Key, SDL_Scancode>{
-       {Key::NONE, SDL_SCANCODE_UNKNOWN},
-       {Key::RIGHT, SDL_SCANCODE_D},
-       {Key::LEFT, SDL_SCANCODE_A},
-       {Key::JUMP, SDL_SCANCODE_SPACE},
-       {Key::DUCK, SDL_SCANCODE_S},
-       {Key::SPRINT, SDL_SCANCODE_LSHIFT},
-       {Key::FIREBALL, SDL_SCANCODE_Q},
-       {Key::MENU_UP, SDL_SCANCODE_UP},
-       {Key::MENU_DOWN, SDL_SCANCODE_DOWN},
-       {Key::MENU_LEFT, SDL_SCANCODE_LEFT},
-       {Key::MENU_RIGHT, SDL_SCANCODE_RIGHT},
-       {Key::MENU_ACCEPT, SDL_SCANCODE_RETURN},
-       {Key::MENU_ESCAPE, SDL_SCANCODE_ESCAPE},
-       {Key::PAUSE, SDL_SCANCODE_ESCAPE},
-   };
+   keyBindings[(int)Key::NONE] = SDL_SCANCODE_UNKNOWN;
+   keyBindings[(int)Key::RIGHT] = SDL_SCANCODE_D;
+   keyBindings[(int)Key::LEFT] = SDL_SCANCODE_A;
+   keyBindings[(int)Key::JUMP] = SDL_SCANCODE_SPACE;
+   keyBindings[(int)Key::DUCK] = SDL_SCANCODE_S;
+   keyBindings[(int)Key::SPRINT] = SDL_SCANCODE_LSHIFT;
+   keyBindings[(int)Key::FIREBALL] = SDL_SCANCODE_Q;
+   keyBindings[(int)Key::MENU_UP] = SDL_SCANCODE_UP;
+   keyBindings[(int)Key::MENU_DOWN] = SDL_SCANCODE_DOWN;
+   keyBindings[(int)Key::MENU_LEFT] = SDL_SCANCODE_LEFT;
+   keyBindings[(int)Key::MENU_RIGHT] = SDL_SCANCODE_RIGHT;
+   keyBindings[(int)Key::MENU_ACCEPT] = SDL_SCANCODE_RETURN;
+   keyBindings[(int)Key::MENU_ESCAPE] = SDL_SCANCODE_ESCAPE;
+   keyBindings[(int)Key::PAUSE] = SDL_SCANCODE_ESCAPE;
 
-   for (auto key : keyBindings) {
-      keysPressed.insert({key.first, false});
-      keysHeld.insert({key.first, false});
-   }
+   keysDown.reset();
+   keysHeld.reset();
 }
 
 void Input::set(Key action, SDL_Scancode keyCode) {
-   keyBindings.insert_or_assign(action, keyCode);
-   keysPressed.insert_or_assign(action, false);
-   keysHeld.insert_or_assign(action, false);
+   keyBindings[(int)action] = keyCode;
+   keysDown.reset((int)action);
+   keysHeld.reset((int)action);
 }
 
 void Input::update(const Uint8* keystates) {
-   currentRawKeys.clear();
+   KeySet down;
 
-   for (auto key : keyBindings) {
-      // If key pressed
-      if (keystates[key.second]) {
-         // Sets the key to be held if it is already pressed
-         keysHeld.insert_or_assign(key.first, keysPressed.at(key.first));
-         // Sets the key to be pressed
-         keysPressed.insert_or_assign(key.first, true);
-      } else {
-         // Sets pressed and held to false if the key is not being currently pressed
-         keysPressed.insert_or_assign(key.first, false);
-         keysHeld.insert_or_assign(key.first, false);
-      }
+   for (int key = 0; key < (int)Key::COUNT; key++) {
+      down[key] = keystates[keyBindings[key]] != 0;
    }
+
+   update(down);
+}
+
+void Input::update(KeySet down) {
+   currentRawKeys.clear();
+
+   // A key is held if it was already down on the last update, and a key that is let go of is
+   // neither
+   keysHeld = keysDown & down;
+   keysDown = down;
 }
 
 SDL_Scancode Input::getBoundKey(Key action) {
-   return keyBindings.at(action);
+   return keyBindings[(int)action];
 }
 
 bool Input::getRawKey(Key action) {
-   return keysPressed.at(action);
+   return keysDown[(int)action];
 }
 
 bool Input::getKeyPressed(Key action) {
-   return keysPressed.at(action) && !keysHeld.at(action);
+   return keysDown[(int)action] && !keysHeld[(int)action];
 }
 
 bool Input::getKeyHeld(Key action) {
-   return keysHeld.at(action);
+   return keysHeld[(int)action];
 }
 
 std::vector<SDL_Scancode>& Input::getCurrentRawKeys() {
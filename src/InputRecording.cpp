@@ -0,0 +1,145 @@
+#include "InputRecording.h"
+
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <limits>
+
+namespace {
+
+constexpr char MAGIC[8] = {'S', 'M', 'B', 'I', 'N', 'P', 'U', 'T'};
+constexpr uint8_t VERSION = 1;
+constexpr std::size_t HEADER_SIZE = sizeof(MAGIC) + 2;
+constexpr std::size_t RUN_SIZE = 4;
+
+static_assert((int)Key::COUNT <= 16, "Every Key has to fit in the 16 bits of a run");
+
+void writeUint16(std::ostream& stream, uint16_t value) {
+   stream.put((char)(value & 0xFF));
+   stream.put((char)(value >> 8));
+}
+
+uint16_t readUint16(const unsigned char* bytes) {
+   return (uint16_t)(bytes[0] | (bytes[1] << 8));
+}
+
+}  // namespace
+
+InputRecorder::~InputRecorder() {
+   stop();
+}
+
+int InputRecorder::start(const std::string& path) {
+   this->path = path;
+
+   file.open(path, std::ios::binary | std::ios::trunc);
+   if (!file) {
+      std::cerr << "Failed to Open Input Recording " << path << std::endl;
+      return -1;
+   }
+
+   file.write(MAGIC, sizeof(MAGIC));
+   file.put((char)VERSION);
+   file.put((char)Key::COUNT);
+
+   runKeys = 0;
+   runLength = 0;
+   tickCount = 0;
+
+   return 0;
+}
+
+void InputRecorder::record(KeySet keysDown) {
+   if (!file.is_open()) {
+      return;
+   }
+
+   uint16_t keys = (uint16_t)keysDown.to_ulong();
+
+   if (runLength > 0 && (keys != runKeys || runLength == std::numeric_limits<uint16_t>::max())) {
+      writeRun();
+   }
+
+   runKeys = keys;
+   runLength++;
+   tickCount++;
+}
+
+void InputRecorder::writeRun() {
+   writeUint16(file, runKeys);
+   writeUint16(file, runLength);
+
+   runLength = 0;
+}
+
+void InputRecorder::stop() {
+   if (!file.is_open()) {
+      return;
+   }
+
+   if (runLength > 0) {
+      writeRun();
+   }
+   file.close();
+
+   std::cout << "Recorded " << tickCount << " ticks of input to " << path << std::endl;
+}
+
+int InputPlayer::start(const std::string& path) {
+   this->path = path;
+
+   std::ifstream file(path, std::ios::binary);
+   if (!file) {
+      std::cerr << "Failed to Open Input Recording " << path << std::endl;
+      return -1;
+   }
+
+   std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)),
+                                    std::istreambuf_iterator<char>());
+
+   if (bytes.size() < HEADER_SIZE || std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+       bytes[sizeof(MAGIC)] != VERSION || bytes[sizeof(MAGIC) + 1] != (int)Key::COUNT ||
+       (bytes.size() - HEADER_SIZE) % RUN_SIZE != 0) {
+      std::cerr << "Failed to Read Input Recording " << path
+                << ": it isn't a recording of this version of the game" << std::endl;
+      return -1;
+   }
+
+   runs.clear();
+   for (std::size_t offset = HEADER_SIZE; offset < bytes.size(); offset += RUN_SIZE) {
+      Run run{readUint16(&bytes[offset]), readUint16(&bytes[offset + 2])};
+
+      if (run.length > 0) {
+         runs.push_back(run);
+      }
+   }
+
+   currentRun = 0;
+   runTick = 0;
+   tickCount = 0;
+   playing = true;
+
+   return 0;
+}
+
+bool InputPlayer::next(KeySet& keysDown) {
+   if (currentRun >= runs.size()) {
+      if (playing) {
+         std::cout << "Played back " << tickCount << " ticks of input from " << path << std::endl;
+      }
+
+      keysDown.reset();
+      playing = false;
+      return false;
+   }
+
+   keysDown = KeySet(runs[currentRun].keys);
+   tickCount++;
+
+   if (++runTick == runs[currentRun].length) {
+      currentRun++;
+      runTick = 0;
+   }
+
+   return true;
+}
@@ -0,0 +1,491 @@
+#include "LevelFile.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+// Every layer, followed by the level properties
+constexpr int SOURCE_COUNT = (int)LevelLayer::COUNT + 1;
+constexpr int PROPERTIES_SOURCE = (int)LevelLayer::COUNT;
+
+constexpr char MAGIC[4] = {'S', 'M', 'B', 'L'};
+
+const char* const LAYER_SUFFIXES[(int)LevelLayer::COUNT] = {
+    "_Foreground.csv", "_Background.csv",        "_Underground.csv",
+    "_Enemies.csv",    "_Above_Foreground.csv", "_Collectibles.csv"};
+
+/*
+ * The file starts with a FileHeader, every Section points to an array of records after it. All
+ * records are made of 32 bit integers and are aligned to 8 bytes, so they can be read straight out
+ * of the mapped file. Sources that didn't exist when the level was compiled have a size of -1.
+ * */
+
+struct SourceStamp {
+   int64_t fileSize;
+   int64_t modifiedTime;
+};
+
+struct Section {
+   uint32_t offset;
+   uint32_t count;
+};
+
+struct LayerRecord {
+   uint32_t offset;
+   int32_t width;
+   int32_t height;
+};
+
+struct PointRecord {
+   int32_t x;
+   int32_t y;
+};
+
+struct WarpPipeRecord {
+   PointRecord pipe;
+   PointRecord teleport;
+   PointRecord camera;
+   int32_t inDirection;
+   int32_t outDirection;
+   int32_t cameraFreeze;
+   int32_t backgroundColor;
+   int32_t levelType;
+   PointRecord newLevel;
+};
+
+struct MovingPlatformRecord {
+   PointRecord position;
+   int32_t motionType;
+   int32_t direction;
+   PointRecord minMax;
+   int32_t shift;
+};
+
+struct PlatformLevelRecord {
+   PointRecord left;
+   PointRecord right;
+   int32_t pulleyLevel;
+};
+
+struct FireBarRecord {
+   PointRecord position;
+   int32_t startAngle;
+   int32_t rotation;
+   int32_t length;
+};
+
+struct VineRecord {
+   PointRecord block;
+   PointRecord teleport;
+   PointRecord camera;
+   int32_t resetY;
+   PointRecord resetTeleport;
+   int32_t newCameraMax;
+   int32_t backgroundColor;
+   int32_t levelType;
+};
+
+struct FloatingTextRecord {
+   PointRecord position;
+   uint32_t textOffset;  // Offset into the text section
+   uint32_t textLength;
+};
+
+struct FileHeader {
+   char magic[4];
+   uint32_t version;
+
+   SourceStamp sources[SOURCE_COUNT];
+
+   PointRecord playerStart;
+   PointRecord cameraStart;
+   PointRecord nextLevel;
+   int32_t levelType;
+   int32_t backgroundColor;
+   int32_t cameraMax;
+
+   Section teleportPoints;
+   Section warpPipes;
+   Section movingPlatforms;
+   Section platformLevels;
+   Section fireBars;
+   Section vines;
+   Section floatingTexts;
+   Section text;
+
+   LayerRecord layers[(int)LevelLayer::COUNT];
+};
+
+constexpr std::size_t RECORD_ALIGNMENT = 8;
+
+SourceStamp getSourceStamp(const std::string& path) {
+   std::error_code error;
+
+   std::uintmax_t fileSize = std::filesystem::file_size(path, error);
+   if (error) {
+      return SourceStamp{-1, -1};
+   }
+
+   auto modifiedTime = std::filesystem::last_write_time(path, error);
+   if (error) {
+      return SourceStamp{-1, -1};
+   }
+
+   return SourceStamp{(int64_t)fileSize, (int64_t)modifiedTime.time_since_epoch().count()};
+}
+
+PointRecord toRecord(Vector2i point) {
+   return PointRecord{point.x, point.y};
+}
+
+Vector2i toVector(PointRecord point) {
+   return Vector2i(point.x, point.y);
+}
+
+void alignBuffer(std::vector<char>& buffer) {
+   buffer.resize((buffer.size() + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT * RECORD_ALIGNMENT);
+}
+
+template <typename T>
+Section appendRecords(std::vector<char>& buffer, const T* records, std::size_t count) {
+   alignBuffer(buffer);
+
+   Section section{(uint32_t)buffer.size(), (uint32_t)count};
+
+   const char* bytes = reinterpret_cast<const char*>(records);
+   buffer.insert(buffer.end(), bytes, bytes + count * sizeof(T));
+
+   return section;
+}
+
+template <typename T>
+Section appendRecords(std::vector<char>& buffer, const std::vector<T>& records) {
+   return appendRecords(buffer, records.data(), records.size());
+}
+
+bool sectionFits(const Section& section, std::size_t recordSize, std::size_t fileSize) {
+   return section.offset % RECORD_ALIGNMENT == 0 && section.offset <= fileSize &&
+          section.count <= (fileSize - section.offset) / recordSize;
+}
+
+}  // namespace
+
+std::string LevelFile::getLayerPath(const std::string& mapDataPath, LevelLayer layer) {
+   return mapDataPath + LAYER_SUFFIXES[(int)layer];
+}
+
+int LevelFile::compile(const std::string& mapDataPath) {
+   std::vector<char> buffer(sizeof(FileHeader));
+
+   FileHeader header{};
+   memcpy(header.magic, MAGIC, sizeof(MAGIC));
+   header.version = VERSION;
+
+   for (int layer = 0; layer < (int)LevelLayer::COUNT; layer++) {
+      std::string layerPath = getLayerPath(mapDataPath, (LevelLayer)layer);
+
+      header.sources[layer] = getSourceStamp(layerPath);
+
+      Map layerMap(layerPath.c_str());
+      const TileGrid& layerData = layerMap.getLevelData();
+
+      std::vector<int16_t> tiles;
+      tiles.reserve(layerData.getTiles().size());
+
+      for (int tile : layerData.getTiles()) {
+         if (tile < INT16_MIN || tile > INT16_MAX) {
+            std::cerr << "Failed to Compile " << layerPath << ": tile " << tile
+                      << " doesn't fit in 16 bits" << std::endl;
+            return -1;
+         }
+         tiles.push_back((int16_t)tile);
+      }
+
+      Section tileSection = appendRecords(buffer, tiles);
+
+      header.layers[layer] =
+          LayerRecord{tileSection.offset, layerData.getWidth(), layerData.getHeight()};
+   }
+
+   std::string propertiesPath = getPropertiesPath(mapDataPath);
+
+   header.sources[PROPERTIES_SOURCE] = getSourceStamp(propertiesPath);
+
+   std::ifstream propertiesFile(propertiesPath);
+   if (!propertiesFile.is_open()) {
+      std::cerr << "Failed to Open " << propertiesPath << std::endl;
+      return -1;
+   }
+
+   std::ostringstream propertiesStream;
+   propertiesStream << propertiesFile.rdbuf();
+
+   // Elements with errors are printed and left out, the same as when the game loads the level
+   Level level;
+   level.loadLevelData(propertiesStream.str(), propertiesPath);
+
+   const LevelData& data = level.getData();
+
+   header.playerStart = toRecord(data.playerStart);
+   header.cameraStart = toRecord(data.cameraStart);
+   header.nextLevel = toRecord(data.nextLevel);
+   header.levelType = (int32_t)data.levelType;
+   header.backgroundColor = (int32_t)data.levelBackgroundColor;
+   header.cameraMax = data.cameraMax;
+
+   std::vector<PointRecord> teleportPoints;
+   for (const Vector2i& point : data.teleportPoints) {
+      teleportPoints.push_back(toRecord(point));
+   }
+   header.teleportPoints = appendRecords(buffer, teleportPoints);
+
+   std::vector<WarpPipeRecord> warpPipes;
+   for (const WarpPipeData& pipe : data.warpPipeLocations) {
+      warpPipes.push_back(WarpPipeRecord{
+          toRecord(std::get<0>(pipe)), toRecord(std::get<1>(pipe)), toRecord(std::get<2>(pipe)),
+          (int32_t)std::get<3>(pipe), (int32_t)std::get<4>(pipe), std::get<5>(pipe),
+          (int32_t)std::get<6>(pipe), (int32_t)std::get<7>(pipe), toRecord(std::get<8>(pipe))});
+   }
+   header.warpPipes = appendRecords(buffer, warpPipes);
+
+   std::vector<MovingPlatformRecord> movingPlatforms;
+   for (const MovingPlatformData& platform : data.movingPlatformDirections) {
+      movingPlatforms.push_back(MovingPlatformRecord{
+          toRecord(std::get<0>(platform)), (int32_t)std::get<1>(platform),
+          (int32_t)std::get<2>(platform), toRecord(std::get<3>(platform)), std::get<4>(platform)});
+   }
+   header.movingPlatforms = appendRecords(buffer, movingPlatforms);
+
+   std::vector<PlatformLevelRecord> platformLevels;
+   for (const PlatformLevelData& platformLevel : data.platformLevelLocations) {
+      platformLevels.push_back(PlatformLevelRecord{toRecord(std::get<0>(platformLevel)),
+                                                   toRecord(std::get<1>(platformLevel)),
+                                                   std::get<2>(platformLevel)});
+   }
+   header.platformLevels = appendRecords(buffer, platformLevels);
+
+   std::vector<FireBarRecord> fireBars;
+   for (const FireBarData& fireBar : data.fireBarLocations) {
+      fireBars.push_back(FireBarRecord{toRecord(std::get<0>(fireBar)), std::get<1>(fireBar),
+                                       (int32_t)std::get<2>(fireBar), std::get<3>(fireBar)});
+   }
+   header.fireBars = appendRecords(buffer, fireBars);
+
+   std::vector<VineRecord> vines;
+   for (const VineData& vine : data.vineLocations) {
+      vines.push_back(VineRecord{toRecord(std::get<0>(vine)), toRecord(std::get<1>(vine)),
+                                 toRecord(std::get<2>(vine)), std::get<3>(vine),
+                                 toRecord(std::get<4>(vine)), std::get<5>(vine),
+                                 (int32_t)std::get<6>(vine), (int32_t)std::get<7>(vine)});
+   }
+   header.vines = appendRecords(buffer, vines);
+
+   std::string text;
+   std::vector<FloatingTextRecord> floatingTexts;
+   for (const FloatingText& floatingText : data.floatingTextLocations) {
+      const string& message = std::get<1>(floatingText);
+
+      floatingTexts.push_back(FloatingTextRecord{toRecord(std::get<0>(floatingText)),
+                                                 (uint32_t)text.size(), (uint32_t)message.size()});
+      text += message;
+   }
+   header.floatingTexts = appendRecords(buffer, floatingTexts);
+   header.text = appendRecords(buffer, text.data(), text.size());
+
+   memcpy(buffer.data(), &header, sizeof(FileHeader));
+
+   // Written to a temporary file first, so the game never maps a half written level
+   std::string compiledPath = getCompiledPath(mapDataPath);
+   std::string temporaryPath = compiledPath + ".tmp";
+   {
+      std::ofstream compiledFile(temporaryPath, std::ios::binary | std::ios::trunc);
+      compiledFile.write(buffer.data(), buffer.size());
+
+      if (!compiledFile) {
+         std::cerr << "Failed to Write " << temporaryPath << std::endl;
+         return -1;
+      }
+   }
+
+   std::error_code error;
+   std::filesystem::rename(temporaryPath, compiledPath, error);
+   if (error) {
+      std::cerr << "Failed to Write " << compiledPath << ": " << error.message() << std::endl;
+      return -1;
+   }
+
+   return (int)buffer.size();
+}
+
+bool LevelFile::open(const std::string& mapDataPath) {
+   close();
+
+   if (!file.open(getCompiledPath(mapDataPath))) {
+      return false;
+   }
+
+   if (!isValid()) {
+      std::cerr << getCompiledPath(mapDataPath) << " is invalid, loading the CSV files instead"
+                << std::endl;
+      close();
+      return false;
+   }
+
+   const FileHeader* header = at<FileHeader>(0);
+
+   for (int source = 0; source < SOURCE_COUNT; source++) {
+      std::string sourcePath = (source == PROPERTIES_SOURCE)
+                                   ? getPropertiesPath(mapDataPath)
+                                   : getLayerPath(mapDataPath, (LevelLayer)source);
+
+      SourceStamp stamp = getSourceStamp(sourcePath);
+
+      // Only the compiled level has to be shipped, so sources that are missing don't matter
+      if (stamp.fileSize < 0) {
+         continue;
+      }
+
+      if (stamp.fileSize != header->sources[source].fileSize ||
+          stamp.modifiedTime != header->sources[source].modifiedTime) {
+         std::cerr << getCompiledPath(mapDataPath)
+                   << " is out of date, loading the CSV files instead" << std::endl;
+         close();
+         return false;
+      }
+   }
+
+   return true;
+}
+
+void LevelFile::close() {
+   file.close();
+}
+
+bool LevelFile::isValid() const {
+   if (file.size() < sizeof(FileHeader)) {
+      return false;
+   }
+
+   const FileHeader* header = at<FileHeader>(0);
+
+   if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION) {
+      return false;
+   }
+
+   for (const LayerRecord& layer : header->layers) {
+      if (layer.width < 0 || layer.height < 0 ||
+          !sectionFits(Section{layer.offset, (uint32_t)layer.width * (uint32_t)layer.height},
+                       sizeof(int16_t), file.size())) {
+         return false;
+      }
+   }
+
+   return sectionFits(header->teleportPoints, sizeof(PointRecord), file.size()) &&
+          sectionFits(header->warpPipes, sizeof(WarpPipeRecord), file.size()) &&
+          sectionFits(header->movingPlatforms, sizeof(MovingPlatformRecord), file.size()) &&
+          sectionFits(header->platformLevels, sizeof(PlatformLevelRecord), file.size()) &&
+          sectionFits(header->fireBars, sizeof(FireBarRecord), file.size()) &&
+          sectionFits(header->vines, sizeof(VineRecord), file.size()) &&
+          sectionFits(header->floatingTexts, sizeof(FloatingTextRecord), file.size()) &&
+          sectionFits(header->text, sizeof(char), file.size());
+}
+
+TileLayerView LevelFile::getLayer(LevelLayer layer) const {
+   const LayerRecord& record = at<FileHeader>(0)->layers[(int)layer];
+
+   return TileLayerView{at<int16_t>(record.offset), record.width, record.height};
+}
+
+void LevelFile::loadLevelData(LevelData& data) const {
+   const FileHeader* header = at<FileHeader>(0);
+
+   data.playerStart = toVector(header->playerStart);
+   data.cameraStart = toVector(header->cameraStart);
+   data.nextLevel = toVector(header->nextLevel);
+   data.levelType = (LevelType)header->levelType;
+   data.levelBackgroundColor = (BackgroundColor)header->backgroundColor;
+   data.cameraMax = header->cameraMax;
+
+   data.teleportPoints.clear();
+   const PointRecord* teleportPoints = at<PointRecord>(header->teleportPoints.offset);
+   for (uint32_t i = 0; i < header->teleportPoints.count; i++) {
+      data.teleportPoints.push_back(toVector(teleportPoints[i]));
+   }
+
+   data.warpPipeLocations.clear();
+   const WarpPipeRecord* warpPipes = at<WarpPipeRecord>(header->warpPipes.offset);
+   for (uint32_t i = 0; i < header->warpPipes.count; i++) {
+      const WarpPipeRecord& pipe = warpPipes[i];
+
+      data.warpPipeLocations.push_back(
+          WarpPipeData(toVector(pipe.pipe), toVector(pipe.teleport), toVector(pipe.camera),
+                       (Direction)pipe.inDirection, (Direction)pipe.outDirection,
+                       pipe.cameraFreeze != 0, (BackgroundColor)pipe.backgroundColor,
+                       (LevelType)pipe.levelType, toVector(pipe.newLevel)));
+   }
+
+   data.movingPlatformDirections.clear();
+   const MovingPlatformRecord* movingPlatforms =
+       at<MovingPlatformRecord>(header->movingPlatforms.offset);
+   for (uint32_t i = 0; i < header->movingPlatforms.count; i++) {
+      const MovingPlatformRecord& platform = movingPlatforms[i];
+
+      data.movingPlatformDirections.push_back(MovingPlatformData(
+          toVector(platform.position), (PlatformMotionType)platform.motionType,
+          (Direction)platform.direction, toVector(platform.minMax), platform.shift != 0));
+   }
+
+   data.platformLevelLocations.clear();
+   const PlatformLevelRecord* platformLevels =
+       at<PlatformLevelRecord>(header->platformLevels.offset);
+   for (uint32_t i = 0; i < header->platformLevels.count; i++) {
+      const PlatformLevelRecord& platformLevel = platformLevels[i];
+
+      data.platformLevelLocations.push_back(PlatformLevelData(
+          toVector(platformLevel.left), toVector(platformLevel.right), platformLevel.pulleyLevel));
+   }
+
+   data.fireBarLocations.clear();
+   const FireBarRecord* fireBars = at<FireBarRecord>(header->fireBars.offset);
+   for (uint32_t i = 0; i < header->fireBars.count; i++) {
+      const FireBarRecord& fireBar = fireBars[i];
+
+      data.fireBarLocations.push_back(FireBarData(toVector(fireBar.position), fireBar.startAngle,
+                                                  (RotationDirection)fireBar.rotation,
+                                                  fireBar.length));
+   }
+
+   data.vineLocations.clear();
+   const VineRecord* vines = at<VineRecord>(header->vines.offset);
+   for (uint32_t i = 0; i < header->vines.count; i++) {
+      const VineRecord& vine = vines[i];
+
+      data.vineLocations.push_back(
+          VineData(toVector(vine.block), toVector(vine.teleport), toVector(vine.camera),
+                   vine.resetY, toVector(vine.resetTeleport), vine.newCameraMax,
+                   (BackgroundColor)vine.backgroundColor, (LevelType)vine.levelType));
+   }
+
+   data.floatingTextLocations.clear();
+   const FloatingTextRecord* floatingTexts = at<FloatingTextRecord>(header->floatingTexts.offset);
+   const char* text = at<char>(header->text.offset);
+   for (uint32_t i = 0; i < header->floatingTexts.count; i++) {
+      const FloatingTextRecord& floatingText = floatingTexts[i];
+
+      if (floatingText.textOffset > header->text.count ||
+          floatingText.textLength > header->text.count - floatingText.textOffset) {
+         continue;
+      }
+
+      data.floatingTextLocations.push_back(
+          FloatingText(toVector(floatingText.position),
+                       string(text + floatingText.textOffset, floatingText.textLength)));
+   }
+
+   data.buildIndexes();
+}
@@ -0,0 +1,55 @@
+#include "LevelLoader.h"
+
+LevelLoader::~LevelLoader() {
+   join();
+   deleteStagedEntities();
+}
+
+void LevelLoader::start(World* world, std::function<void(World*)> loadEntities) {
+   join();
+   deleteStagedEntities();
+
+   this->world = world;
+   finished = false;
+
+#ifdef __EMSCRIPTEN__
+   run(loadEntities);
+#else
+   loaderThread = std::thread(&LevelLoader::run, this, loadEntities);
+#endif
+}
+
+void LevelLoader::run(std::function<void(World*)> loadEntities) {
+   auto startTime = std::chrono::steady_clock::now();
+
+   World::setStagingList(&stagedEntities);
+   loadEntities(world);
+   World::setStagingList(nullptr);
+
+   loadMilliseconds =
+       std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime)
+           .count();
+   entityCount = (int)stagedEntities.size();
+
+   finished = true;
+}
+
+void LevelLoader::publish() {
+   join();
+
+   world->publish(stagedEntities);
+}
+
+void LevelLoader::join() {
+   if (loaderThread.joinable()) {
+      loaderThread.join();
+   }
+}
+
+void LevelLoader::deleteStagedEntities() {
+   for (Entity* entity : stagedEntities) {
+      EventBus::Get().entityDestroyed(entity);
+      delete entity;
+   }
+   stagedEntities.clear();
+}
@@ -0,0 +1,239 @@
+#include "LevelPrefetcher.h"
+
+#include "LevelFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+template <typename Function>
+double timeMilliseconds(Function function) {
+   auto startTime = std::chrono::steady_clock::now();
+   function();
+   return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime)
+       .count();
+}
+
+}  // namespace
+
+void PreparedLevel::load(int level, int subLevel) {
+   this->level = level;
+   this->subLevel = subLevel;
+
+   // The path to the folder that the level files are in
+   std::string folderPath =
+       "res/data/World" + std::to_string(level) + "-" + std::to_string(subLevel) + "/";
+   // The path to the map data files (where the blocks are and stuff)
+   std::string mapDataPath =
+       folderPath + "World" + std::to_string(level) + "-" + std::to_string(subLevel);
+
+   // The compiled level is used as long as it is up to date with the files below. Its layers are
+   // only copied out of the mapped file, which isn't worth a thread each
+   LevelFile levelFile;
+   if (levelFile.open(mapDataPath)) {
+      propertiesMilliseconds = timeMilliseconds([&]() {
+         levelFile.loadLevelData(data);
+      });
+
+      for (int layer = 0; layer < (int)LevelLayer::COUNT; layer++) {
+         layerMilliseconds[layer] = timeMilliseconds([&]() {
+            getMap((LevelLayer)layer).loadMap(levelFile.getLayer((LevelLayer)layer));
+         });
+      }
+      return;
+   }
+
+   auto loadLayer = [this, mapDataPath](int layer) {
+      layerMilliseconds[layer] = timeMilliseconds([&]() {
+         getMap((LevelLayer)layer)
+             .loadMap(LevelFile::getLayerPath(mapDataPath, (LevelLayer)layer).c_str());
+      });
+   };
+
+   // Every thread only writes to its own layer and timing
+   std::vector<std::thread> layerThreads;
+   for (int layer = 0; layer < (int)LevelLayer::COUNT; layer++) {
+#ifdef __EMSCRIPTEN__
+      loadLayer(layer);
+#else
+      layerThreads.emplace_back(loadLayer, layer);
+#endif
+   }
+
+   // Loads the special level properties while the layers are being read
+   propertiesMilliseconds = timeMilliseconds([&]() {
+      std::string propertiesPath = LevelFile::getPropertiesPath(mapDataPath);
+
+      std::ifstream properties(propertiesPath);
+
+      std::string propertiesString;
+
+      if (properties.is_open()) {
+         std::ostringstream ss;
+         ss << properties.rdbuf();
+         propertiesString = ss.str();
+      }
+
+      properties.close();
+
+      Level propertiesLevel;
+      propertiesLevel.loadLevelData(propertiesString, propertiesPath);
+      data = std::move(propertiesLevel.getData());
+   });
+
+   for (std::thread& layerThread : layerThreads) {
+      layerThread.join();
+   }
+}
+
+Map& PreparedLevel::getMap(LevelLayer layer) {
+   switch (layer) {
+      case LevelLayer::BACKGROUND:
+         return backgroundMap;
+      case LevelLayer::UNDERGROUND:
+         return undergroundMap;
+      case LevelLayer::ENEMIES:
+         return enemiesMap;
+      case LevelLayer::ABOVE_FOREGROUND:
+         return aboveForegroundMap;
+      case LevelLayer::COLLECTIBLES:
+         return collectiblesMap;
+      case LevelLayer::FOREGROUND:
+      default:
+         return foregroundMap;
+   }
+}
+
+LevelPrefetcher::~LevelPrefetcher() {
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+      pending.clear();
+   }
+   condition.notify_all();
+
+   if (prefetchThread.joinable()) {
+      prefetchThread.join();
+   }
+}
+
+std::vector<Vector2i> LevelPrefetcher::findNextLevels(int level, int subLevel,
+                                                      const LevelData& data) {
+   std::vector<Vector2i> nextLevels;
+
+   auto addLevel = [&](Vector2i nextLevel) {
+      // (0, 0) means that there is no next level, or that the pipe stays in this level
+      if (nextLevel == Vector2i(0, 0) || nextLevel == Vector2i(level, subLevel)) {
+         return;
+      }
+      if (std::find(nextLevels.begin(), nextLevels.end(), nextLevel) == nextLevels.end()) {
+         nextLevels.push_back(nextLevel);
+      }
+   };
+
+   addLevel(data.nextLevel);
+
+   for (const WarpPipeData& pipe : data.warpPipeLocations) {
+      addLevel(std::get<8>(pipe));
+   }
+
+   return nextLevels;
+}
+
+void LevelPrefetcher::prefetch(const std::vector<Vector2i>& levels) {
+#ifdef __EMSCRIPTEN__
+   // Without threads the levels are loaded when they are switched to, like before
+   return;
+#endif
+
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      pending.clear();
+      for (Vector2i level : levels) {
+         if (cache.find(level) == cache.end() && level != preparing) {
+            pending.push_back(level);
+         }
+      }
+
+      if (pending.empty()) {
+         return;
+      }
+
+      if (!prefetchThread.joinable()) {
+         prefetchThread = std::thread(&LevelPrefetcher::run, this);
+      }
+   }
+   condition.notify_all();
+}
+
+std::shared_ptr<const PreparedLevel> LevelPrefetcher::get(int level, int subLevel,
+                                                          bool* cached) {
+   Vector2i wantedLevel(level, subLevel);
+
+   {
+      std::unique_lock<std::mutex> lock(mutex);
+
+      bool waited = preparing == wantedLevel;
+
+      // Finishing the level that is being prepared is quicker than starting over
+      condition.wait(lock, [&]() {
+         return preparing != wantedLevel;
+      });
+
+      auto it = cache.find(wantedLevel);
+      if (it != cache.end()) {
+         if (cached) {
+            *cached = !waited;
+         }
+         return it->second;
+      }
+
+      pending.erase(std::remove(pending.begin(), pending.end(), wantedLevel), pending.end());
+   }
+
+   if (cached) {
+      *cached = false;
+   }
+
+   auto preparedLevel = std::make_shared<PreparedLevel>();
+   preparedLevel->load(level, subLevel);
+
+   std::lock_guard<std::mutex> lock(mutex);
+   cache[wantedLevel] = preparedLevel;
+
+   return preparedLevel;
+}
+
+void LevelPrefetcher::run() {
+   std::unique_lock<std::mutex> lock(mutex);
+
+   while (true) {
+      condition.wait(lock, [this]() {
+         return stopping || !pending.empty();
+      });
+
+      if (stopping) {
+         return;
+      }
+
+      preparing = pending.front();
+      pending.pop_front();
+
+      lock.unlock();
+
+      auto preparedLevel = std::make_shared<PreparedLevel>();
+      preparedLevel->load(preparing.x, preparing.y);
+
+      lock.lock();
+
+      cache[preparing] = preparedLevel;
+      preparing = Vector2i(0, 0);
+
+      condition.notify_all();
+   }
+}
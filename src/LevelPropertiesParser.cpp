@@ -0,0 +1,451 @@
+#include "LevelPropertiesParser.h"
+
+#include "Level.h"
+
+#include <cctype>
+#include <charconv>
+#include <unordered_map>
+
+namespace {
+
+template <typename T>
+const std::unordered_map<std::string_view, T>& getEnumTable();
+
+template <>
+const std::unordered_map<std::string_view, Direction>& getEnumTable() {
+   static const std::unordered_map<std::string_view, Direction> table = {
+       {"NONE", Direction::NONE}, {"UP", Direction::UP},       {"DOWN", Direction::DOWN},
+       {"LEFT", Direction::LEFT}, {"RIGHT", Direction::RIGHT},
+   };
+   return table;
+}
+
+template <>
+const std::unordered_map<std::string_view, PlatformMotionType>& getEnumTable() {
+   static const std::unordered_map<std::string_view, PlatformMotionType> table = {
+       {"NONE", PlatformMotionType::NONE},
+       {"ONE_DIRECTION_REPEATED", PlatformMotionType::ONE_DIRECTION_REPEATED},
+       {"ONE_DIRECTION_CONTINUOUS", PlatformMotionType::ONE_DIRECTION_CONTINUOUS},
+       {"BACK_AND_FORTH", PlatformMotionType::BACK_AND_FORTH},
+       {"GRAVITY", PlatformMotionType::GRAVITY},
+   };
+   return table;
+}
+
+template <>
+const std::unordered_map<std::string_view, RotationDirection>& getEnumTable() {
+   static const std::unordered_map<std::string_view, RotationDirection> table = {
+       {"NONE", RotationDirection::NONE},
+       {"CLOCKWISE", RotationDirection::CLOCKWISE},
+       {"COUNTER_CLOCKWISE", RotationDirection::COUNTER_CLOCKWISE},
+   };
+   return table;
+}
+
+template <>
+const std::unordered_map<std::string_view, LevelType>& getEnumTable() {
+   static const std::unordered_map<std::string_view, LevelType> table = {
+       {"NONE", LevelType::NONE},
+       {"OVERWORLD", LevelType::OVERWORLD},
+       {"UNDERGROUND", LevelType::UNDERGROUND},
+       {"UNDERWATER", LevelType::UNDERWATER},
+       {"CASTLE", LevelType::CASTLE},
+       {"START_UNDERGROUND", LevelType::START_UNDERGROUND},
+   };
+   return table;
+}
+
+template <>
+const std::unordered_map<std::string_view, BackgroundColor>& getEnumTable() {
+   static const std::unordered_map<std::string_view, BackgroundColor> table = {
+       {"BLACK", BackgroundColor::BLACK},
+       {"BLUE", BackgroundColor::BLUE},
+   };
+   return table;
+}
+
+bool isWordCharacter(char character) {
+   return std::isalnum((unsigned char)character) || character == '_';
+}
+
+}  // namespace
+
+bool LevelPropertiesParser::parse(std::string_view text) {
+   // Properties that are missing from the file keep these values
+   data.playerStart = Vector2i(0, 0);
+   data.cameraStart = Vector2i(0, 0);
+   data.nextLevel = Vector2i(0, 0);
+   data.levelType = LevelType::NONE;
+   data.levelBackgroundColor = BackgroundColor::NONE;
+   data.cameraMax = 0;
+   data.teleportPoints.clear();
+   data.floatingTextLocations.clear();
+   data.warpPipeLocations.clear();
+   data.movingPlatformDirections.clear();
+   data.platformLevelLocations.clear();
+   data.fireBarLocations.clear();
+   data.vineLocations.clear();
+
+   errors.clear();
+   lineNumber = 0;
+
+   Key arrayKey = Key::NONE;  // The array that the following elements belong to
+
+   std::size_t lineStart = 0;
+   while (lineStart < text.size()) {
+      std::size_t lineEnd = text.find('\n', lineStart);
+      if (lineEnd == std::string_view::npos) {
+         lineEnd = text.size();
+      }
+
+      line = text.substr(lineStart, lineEnd - lineStart);
+      lineStart = lineEnd + 1;
+      lineNumber++;
+      column = 0;
+
+      while (!line.empty() && std::isspace((unsigned char)line.back())) {
+         line.remove_suffix(1);
+      }
+
+      skipSpaces();
+
+      // Every element starts with a coordinate, anything else ends the array. Some levels leave out
+      // the ",\\" after an element, so it isn't needed to continue the array
+      if (arrayKey != Key::NONE) {
+         if (column < line.size() && line[column] == '(') {
+            if (line.back() == '\\') {
+               line.remove_suffix(1);
+
+               while (!line.empty() && std::isspace((unsigned char)line.back())) {
+                  line.remove_suffix(1);
+               }
+            }
+            if (!line.empty() && line.back() == ',') {
+               line.remove_suffix(1);
+            }
+
+            parseElement(arrayKey);
+            continue;
+         }
+
+         arrayKey = Key::NONE;
+      }
+
+      if (column == line.size() || line[column] == '#') {
+         continue;
+      }
+
+      std::string_view name;
+      if (!readWord(name)) {
+         addError("expected a property name");
+         continue;
+      }
+
+      Key key = findKey(name);
+      if (key == Key::NONE) {
+         column -= name.size();
+         addError("unknown property " + std::string(name));
+         continue;
+      }
+
+      if (!expect('=')) {
+         continue;
+      }
+
+      if (isArray(key)) {
+         if (expect('\\') && expectEnd()) {
+            arrayKey = key;
+         }
+      } else {
+         parseProperty(key);
+      }
+   }
+
+   data.buildIndexes();
+
+   return errors.empty();
+}
+
+LevelPropertiesParser::Key LevelPropertiesParser::findKey(std::string_view name) {
+   static const std::unordered_map<std::string_view, Key> keys = {
+       {"PLAYER_START", Key::PLAYER_START},
+       {"CAMERA_START", Key::CAMERA_START},
+       {"CAMERA_MAX", Key::CAMERA_MAX},
+       {"LEVEL_TYPE", Key::LEVEL_TYPE},
+       {"NEXT_LEVEL", Key::NEXT_LEVEL},
+       {"BACKGROUND_COLOR", Key::BACKGROUND_COLOR},
+       {"TELEPORT_POINT", Key::TELEPORT_POINT},
+       {"FLOATING_TEXT", Key::FLOATING_TEXT},
+       {"WARP_PIPE", Key::WARP_PIPE},
+       {"MOVING_PLATFORM", Key::MOVING_PLATFORM},
+       {"PLATFORM_LEVEL", Key::PLATFORM_LEVEL},
+       {"FIRE_BAR", Key::FIRE_BAR},
+       {"VINE", Key::VINE},
+   };
+
+   auto it = keys.find(name);
+   return (it != keys.end()) ? it->second : Key::NONE;
+}
+
+bool LevelPropertiesParser::isArray(Key key) {
+   return key >= Key::TELEPORT_POINT;
+}
+
+void LevelPropertiesParser::parseProperty(Key key) {
+   Vector2i point;
+   int value;
+
+   switch (key) {
+      case Key::PLAYER_START:
+         if (readPoint(point) && expectEnd()) {
+            data.playerStart = point;
+         }
+         break;
+      case Key::CAMERA_START:
+         if (readPoint(point) && expectEnd()) {
+            data.cameraStart = point;
+         }
+         break;
+      case Key::NEXT_LEVEL:
+         if (readPoint(point) && expectEnd()) {
+            data.nextLevel = point;
+         }
+         break;
+      case Key::CAMERA_MAX:
+         if (readInt(value) && expectEnd()) {
+            data.cameraMax = value;
+         }
+         break;
+      case Key::LEVEL_TYPE: {
+         LevelType levelType;
+         if (readEnum(levelType) && expectEnd()) {
+            data.levelType = levelType;
+         }
+      } break;
+      case Key::BACKGROUND_COLOR: {
+         BackgroundColor color;
+         if (readEnum(color) && expectEnd()) {
+            data.levelBackgroundColor = color;
+         }
+      } break;
+      default:
+         break;
+   }
+}
+
+void LevelPropertiesParser::parseElement(Key key) {
+   switch (key) {
+      case Key::TELEPORT_POINT: {
+         Vector2i point;
+
+         if (readPoint(point) && expectEnd()) {
+            data.teleportPoints.push_back(point);
+         }
+      } break;
+      case Key::FLOATING_TEXT: {
+         Vector2i textLocation;
+         std::string text;
+
+         if (readPoint(textLocation) && readText(text) && expectEnd()) {
+            data.floatingTextLocations.push_back(FloatingText(textLocation, text));
+         }
+      } break;
+      case Key::WARP_PIPE: {
+         Vector2i pipeCoordinates, teleportCoordinates, cameraCoordinates, newLevel;
+         Direction inDirection, outDirection;
+         bool cameraFreeze;
+         BackgroundColor color;
+         LevelType levelType;
+
+         if (readPoint(pipeCoordinates) && readPoint(teleportCoordinates) &&
+             readPoint(cameraCoordinates) && readEnum(inDirection) && readEnum(outDirection) &&
+             readBool(cameraFreeze) && readEnum(color) && readEnum(levelType) &&
+             readPoint(newLevel) && expectEnd()) {
+            data.warpPipeLocations.push_back(WarpPipeData(pipeCoordinates, teleportCoordinates,
+                                                          cameraCoordinates, inDirection,
+                                                          outDirection, cameraFreeze, color,
+                                                          levelType, newLevel));
+         }
+      } break;
+      case Key::MOVING_PLATFORM: {
+         Vector2i platformLocation, platformMinMax;
+         PlatformMotionType motionType;
+         Direction movingDirection;
+         bool rightShift;
+
+         if (readPoint(platformLocation) && readEnum(motionType) && readEnum(movingDirection) &&
+             readPoint(platformMinMax) && readBool(rightShift) && expectEnd()) {
+            data.movingPlatformDirections.push_back(MovingPlatformData(
+                platformLocation, motionType, movingDirection, platformMinMax, rightShift));
+         }
+      } break;
+      case Key::PLATFORM_LEVEL: {
+         Vector2i leftPlatformLocation, rightPlatformLocation;
+         int pulleyLevel;
+
+         if (readPoint(leftPlatformLocation) && readPoint(rightPlatformLocation) &&
+             readInt(pulleyLevel) && expectEnd()) {
+            data.platformLevelLocations.push_back(
+                PlatformLevelData(leftPlatformLocation, rightPlatformLocation, pulleyLevel));
+         }
+      } break;
+      case Key::FIRE_BAR: {
+         Vector2i barCoordinates;
+         int startAngle, barLength;
+         RotationDirection rotationDirection;
+
+         if (readPoint(barCoordinates) && readInt(startAngle) && readEnum(rotationDirection) &&
+             readInt(barLength) && expectEnd()) {
+            data.fireBarLocations.push_back(
+                FireBarData(barCoordinates, startAngle, rotationDirection, barLength));
+         }
+      } break;
+      case Key::VINE: {
+         Vector2i blockLocation, teleportLocation, cameraCoordinates, resetTeleportLocation;
+         int resetYValue, newCameraMax;
+         BackgroundColor backgroundColor;
+         LevelType levelType;
+
+         if (readPoint(blockLocation) && readPoint(teleportLocation) &&
+             readPoint(cameraCoordinates) && readInt(resetYValue) &&
+             readPoint(resetTeleportLocation) && readInt(newCameraMax) &&
+             readEnum(backgroundColor) && readEnum(levelType) && expectEnd()) {
+            data.vineLocations.push_back(VineData(blockLocation, teleportLocation,
+                                                  cameraCoordinates, resetYValue,
+                                                  resetTeleportLocation, newCameraMax,
+                                                  backgroundColor, levelType));
+         }
+      } break;
+      default:
+         break;
+   }
+}
+
+bool LevelPropertiesParser::readPoint(Vector2i& point) {
+   int x, y;
+
+   if (expect('(') && readInt(x) && expect(',') && readInt(y) && expect(')')) {
+      point = Vector2i(x, y);
+      return true;
+   }
+   return false;
+}
+
+bool LevelPropertiesParser::readInt(int& value) {
+   skipSpaces();
+
+   std::size_t start = column;
+   if (column < line.size() && line[column] == '+') {
+      start++;
+   }
+
+   auto [end, error] = std::from_chars(line.data() + start, line.data() + line.size(), value);
+
+   if (error != std::errc()) {
+      addError("expected a number");
+      return false;
+   }
+
+   column = end - line.data();
+   return true;
+}
+
+bool LevelPropertiesParser::readBool(bool& value) {
+   std::string_view word;
+   if (!readWord(word)) {
+      addError("expected TRUE or FALSE");
+      return false;
+   }
+
+   if (word == "TRUE" || word == "FALSE") {
+      value = word == "TRUE";
+      return true;
+   }
+
+   column -= word.size();
+   addError("expected TRUE or FALSE, found " + std::string(word));
+   return false;
+}
+
+bool LevelPropertiesParser::readWord(std::string_view& word) {
+   skipSpaces();
+
+   std::size_t start = column;
+   while (column < line.size() && isWordCharacter(line[column])) {
+      column++;
+   }
+
+   word = line.substr(start, column - start);
+   return !word.empty();
+}
+
+bool LevelPropertiesParser::readText(std::string& text) {
+   if (!expect('(')) {
+      return false;
+   }
+
+   // The text can contain brackets itself, so it goes on until the last bracket of the element
+   std::size_t end = line.rfind(')');
+   if (end == std::string_view::npos || end < column) {
+      addError("expected ')' after the text");
+      return false;
+   }
+
+   text = std::string(line.substr(column, end - column));
+   column = end + 1;
+   return true;
+}
+
+template <typename T>
+bool LevelPropertiesParser::readEnum(T& value) {
+   std::string_view word;
+   if (!readWord(word)) {
+      addError("expected a name");
+      return false;
+   }
+
+   const auto& table = getEnumTable<T>();
+
+   auto it = table.find(word);
+   if (it == table.end()) {
+      column -= word.size();
+      addError("unknown value " + std::string(word));
+      return false;
+   }
+
+   value = it->second;
+   return true;
+}
+
+void LevelPropertiesParser::skipSpaces() {
+   while (column < line.size() && std::isspace((unsigned char)line[column])) {
+      column++;
+   }
+}
+
+bool LevelPropertiesParser::expect(char character) {
+   skipSpaces();
+
+   if (column < line.size() && line[column] == character) {
+      column++;
+      return true;
+   }
+
+   addError(std::string("expected '") + character + "'");
+   return false;
+}
+
+bool LevelPropertiesParser::expectEnd() {
+   skipSpaces();
+
+   if (column == line.size()) {
+      return true;
+   }
+
+   addError("unexpected '" + std::string(line.substr(column)) + "'");
+   return false;
+}
+
+void LevelPropertiesParser::addError(const std::string& message) {
+   errors.push_back(Error{lineNumber, (int)column + 1, message});
+}
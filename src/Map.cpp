@@ -5,13 +5,79 @@
 #include <regex>
 #include <sstream>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
-std::unordered_map<int, Vector2i> Map::BlockIDCoordinates;
-std::unordered_map<int, Vector2i> Map::PlayerIDCoordinates;
-std::unordered_map<int, Vector2i> Map::EnemyIDCoordinates;
-std::unordered_map<int, int> Map::IrregularBlockReferences;
+namespace {
+
+constexpr int BLOCK_ID_COUNT = Map::BLOCK_SHEET_COLUMNS * Map::BLOCK_SHEET_ROWS;
+constexpr int ENEMY_ID_COUNT = Map::ENEMY_SHEET_COLUMNS * Map::ENEMY_SHEET_ROWS;
+
+constexpr auto BLOCK_ID_COORDINATES =
+    makeSpriteIDCoordinates<Map::BLOCK_SHEET_COLUMNS, Map::BLOCK_SHEET_ROWS>();
+constexpr auto PLAYER_ID_COORDINATES =
+    makeSpriteIDCoordinates<Map::PLAYER_SHEET_COLUMNS, Map::PLAYER_SHEET_ROWS>();
+constexpr auto ENEMY_ID_COORDINATES =
+    makeSpriteIDCoordinates<Map::ENEMY_SHEET_COLUMNS, Map::ENEMY_SHEET_ROWS>();
+
+// The blocks to the right of the Overworld blocks (columns 16-31 and 32-47) and below them (rows
+// 11-21) are the same blocks in other colors
+constexpr std::array<int, BLOCK_ID_COUNT> makeReferenceBlockIDs() {
+   std::array<int, BLOCK_ID_COUNT> referenceIDs{};
+
+   for (int id = 0; id < BLOCK_ID_COUNT; id++) {
+      int blockX = id % Map::BLOCK_SHEET_COLUMNS;
+      int blockY = id / Map::BLOCK_SHEET_COLUMNS;
+
+      int referenceX = blockX;
+      int referenceY = blockY;
+
+      if (blockY > 10 && blockX < 32) {
+         referenceY -= 11;
+      }
+
+      if (blockX > 15 && blockX < 32) {
+         referenceX -= 16;
+      } else if (blockX >= 32 && blockY < 10) {
+         referenceX -= 32;
+      }
+
+      referenceIDs[id] = referenceY * Map::BLOCK_SHEET_COLUMNS + referenceX;
+   }
+
+   return referenceIDs;
+}
+
+// Rows 3-11 of the enemy sheet repeat the first three rows in other colors
+constexpr std::array<int, ENEMY_ID_COUNT> makeReferenceEnemyIDs() {
+   std::array<int, ENEMY_ID_COUNT> referenceIDs{};
+
+   for (int id = 0; id < ENEMY_ID_COUNT; id++) {
+      int enemyX = id % Map::ENEMY_SHEET_COLUMNS;
+      int enemyY = id / Map::ENEMY_SHEET_COLUMNS;
+
+      if (enemyY > 2 && enemyY < 12) {
+         enemyY %= 3;
+      }
+
+      referenceIDs[id] = enemyY * Map::ENEMY_SHEET_COLUMNS + enemyX;
+   }
+
+   return referenceIDs;
+}
+
+bool irregularReferencesLoaded = false;
+
+}  // namespace
+
+const SpriteIDTable Map::BlockIDCoordinates(BLOCK_ID_COORDINATES.data(), BLOCK_SHEET_COLUMNS,
+                                            BLOCK_SHEET_ROWS);
+const SpriteIDTable Map::PlayerIDCoordinates(PLAYER_ID_COORDINATES.data(), PLAYER_SHEET_COLUMNS,
+                                             PLAYER_SHEET_ROWS);
+const SpriteIDTable Map::EnemyIDCoordinates(ENEMY_ID_COORDINATES.data(), ENEMY_SHEET_COLUMNS,
+                                            ENEMY_SHEET_ROWS);
+
+std::array<int, BLOCK_ID_COUNT> Map::ReferenceBlockIDs = makeReferenceBlockIDs();
+const std::array<int, ENEMY_ID_COUNT> Map::ReferenceEnemyIDs = makeReferenceEnemyIDs();
 
 Map::Map() {}
 
@@ -21,57 +87,41 @@ Map::Map(const char* dataPath) {
 
 void Map::loadMap(const char* dataPath) {
    std::string line, word;
+   std::vector<int> row;
 
    std::ifstream levelDataFile(dataPath);
    if (levelDataFile.is_open()) {
       while (getline(levelDataFile, line)) {
-         std::vector<int> row;
          std::stringstream ss(line);
 
+         row.clear();
          while (getline(ss, word, ',')) {
             row.push_back(std::stoi(word));
          }
-         levelData.push_back(row);
+         levelData.appendRow(row.begin(), row.end());
       }
    }
    levelDataFile.close();
 }
 
-void Map::reset() {
-   levelData.clear();
-}
+void Map::loadMap(const TileLayerView& layer) {
+   levelData.reserve(layer.width, layer.height);
 
-void Map::loadBlockIDS() {
-   int blockID = 0;
-   for (int i = 0; i < 22; i++) {
-      for (int j = 0; j < 48; j++) {
-         BlockIDCoordinates.insert_or_assign(blockID, Vector2i(j, i));
-         blockID++;
-      }
+   for (int y = 0; y < layer.height; y++) {
+      levelData.appendRow(layer.tiles + y * layer.width, layer.tiles + (y + 1) * layer.width);
    }
 }
 
-void Map::loadPlayerIDS() {
-   int playerID = 0;
-   for (int i = 0; i < 16; i++) {
-      for (int j = 0; j < 25; j++) {
-         PlayerIDCoordinates.insert_or_assign(playerID, Vector2i(j, i));
-         playerID++;
-      }
-   }
+void Map::reset() {
+   levelData.clear();
 }
 
-void Map::loadEnemyIDS() {
-   int enemyID = 0;
-   for (int i = 0; i < 15; i++) {
-      for (int j = 0; j < 35; j++) {
-         EnemyIDCoordinates.insert_or_assign(enemyID, Vector2i(j, i));
-         enemyID++;
-      }
+void Map::loadIrregularBlockReferences() {
+   if (irregularReferencesLoaded) {
+      return;
    }
-}
+   irregularReferencesLoaded = true;
 
-void Map::loadIrregularBlockReferences() {
    std::string line;
 
    std::ifstream idsFile("res/sprites/blocks/IrregularReferences.blockmap");
@@ -80,16 +130,15 @@ void Map::loadIrregularBlockReferences() {
 
    std::smatch pairMatch;
    while (getline(idsFile, line)) {
-      int blockID = 0, referenceID = 0;
+      if (!std::regex_search(line, pairMatch, pairRegex)) {
+         continue;
+      }
+
+      int blockID = std::stoi(pairMatch[1]);
+      int referenceID = std::stoi(pairMatch[2]);
 
-      if (std::regex_search(line, pairMatch, pairRegex)) {
-         blockID = std::stoi(pairMatch[1]);
-         referenceID = std::stoi(pairMatch[2]);
+      if (BlockIDCoordinates.contains(blockID)) {
+         ReferenceBlockIDs[blockID] = referenceID;
       }
-      IrregularBlockReferences.insert_or_assign(blockID, referenceID);
    }
 }
-
-vector<vector<int>> Map::getLevelData() {
-   return levelData;
-}
@@ -1,107 +1,427 @@
 #include "SoundManager.h"
 
-#include <SDL2/SDL.h>
-#include <SDL2/SDL_mixer.h>
-
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 
 SoundManager SoundManager::instance;
 
-int SoundManager::Init() {
-   if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 4, 1024) != 0) {
-      SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Failed to Open Audio: %s", SDL_GetError());
-      std::cerr << "Failed to Open Audio: " << SDL_GetError() << std::endl;
+namespace {
+
+// Cues that tell the player what happened win over the sounds that happen all the time, which are
+// also kept from starting again on every tick
+constexpr std::array<SoundSettings, (int)SoundID::COUNT> SOUND_SETTINGS = {{
+    {40, StealPolicy::LOWER, 2},              // BLOCK_BREAK
+    {30, StealPolicy::LOWER, 4},              // BLOCK_HIT
+    {80, StealPolicy::LOWER_OR_EQUAL, 0},     // BOWSER_FALL
+    {40, StealPolicy::LOWER, 0},              // BOWSER_FIRE
+    {40, StealPolicy::LOWER, 0},              // CANNON_FIRE
+    {30, StealPolicy::LOWER_OR_EQUAL, 2},     // COIN
+    {100, StealPolicy::LOWER_OR_EQUAL, 0},    // DEATH
+    {20, StealPolicy::LOWER_OR_EQUAL, 0},     // FIREBALL
+    {90, StealPolicy::LOWER_OR_EQUAL, 0},     // FLAG_RAISE
+    {100, StealPolicy::LOWER_OR_EQUAL, 0},    // GAME_OVER
+    {30, StealPolicy::LOWER_OR_EQUAL, 0},     // JUMP
+    {30, StealPolicy::LOWER, 2},              // KICK
+    {80, StealPolicy::LOWER_OR_EQUAL, 0},     // ONE_UP
+    {100, StealPolicy::LOWER_OR_EQUAL, 0},    // PAUSE
+    {80, StealPolicy::LOWER_OR_EQUAL, 0},     // PIPE
+    {60, StealPolicy::LOWER, 0},              // POWER_UP_APPEAR
+    {80, StealPolicy::LOWER_OR_EQUAL, 0},     // POWER_UP_COLLECT
+    {80, StealPolicy::LOWER_OR_EQUAL, 0},     // SHRINK
+    {30, StealPolicy::LOWER, 2},              // STOMP
+    {10, StealPolicy::NONE, 0},               // TIMER_TICK
+    {90, StealPolicy::LOWER_OR_EQUAL, 0},     // CASTLE_CLEAR
+}};
+
+constexpr std::array<const char*, (int)SoundID::COUNT> SOUND_PATHS = {
+    "res/sounds/effects/blockbreak.wav",     "res/sounds/effects/blockhit.wav",
+    "res/sounds/effects/bowserfall.wav",     "res/sounds/effects/bowserfire.wav",
+    "res/sounds/effects/cannonfire.wav",     "res/sounds/effects/coin.wav",
+    "res/sounds/effects/death.wav",          "res/sounds/effects/fireball.wav",
+    "res/sounds/effects/flagraise.wav",      "res/sounds/effects/gameover.wav",
+    "res/sounds/effects/jump.wav",           "res/sounds/effects/kick.wav",
+    "res/sounds/effects/oneup.wav",          "res/sounds/effects/pause.wav",
+    "res/sounds/effects/pipe.wav",           "res/sounds/effects/powerupappear.wav",
+    "res/sounds/effects/powerupcollect.wav", "res/sounds/effects/shrink.wav",
+    "res/sounds/effects/stomp.wav",          "res/sounds/effects/timertick.wav",
+    "res/sounds/effects/castleclear.wav",
+};
+
+constexpr std::array<const char*, (int)MusicID::COUNT> MUSIC_PATHS = {
+    "res/sounds/music/overworld.wav",  "res/sounds/music/underground.wav",
+    "res/sounds/music/castle.wav",     "res/sounds/music/underwater.wav",
+    "res/sounds/music/superstar.wav",  "res/sounds/music/gamewon.wav",
+};
+
+}  // namespace
+
+int SoundManager::Init(std::unique_ptr<AudioBackend> backend, int channelCount,
+                       std::size_t musicBudget) {
+   auto startTime = std::chrono::steady_clock::now();
+
+   int openedChannels = backend->open(std::max(channelCount, 1));
+   if (openedChannels < 0) {
       return -1;
    }
 
-   loadSounds();
-   loadMusics();
+   this->backend = std::move(backend);
+
+   voices.resize(openedChannels);
+
+   this->musicBudget = musicBudget;
+
+   std::cout << "Opened " << this->backend->getName() << " audio in "
+             << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                          startTime)
+                    .count()
+             << " ms, sounds and music are loaded when they are first needed" << std::endl;
 
    return 0;
 }
 
+SoundManager::~SoundManager() {
+   stopPreloader();
+}
+
 int SoundManager::Quit() {
+   stopPreloader();
+
+   if (!backend) {
+      return 0;
+   }
+
    stopMusic();
 
-   Mix_CloseAudio();
-   Mix_Quit();
+   for (auto& sound : sounds) {
+      sound.data = AudioData{};
+   }
+   for (auto& music : musics) {
+      music.data = AudioData{};
+   }
+
+   backend->close();
 
    return 0;
 }
 
-std::shared_ptr<Mix_Chunk> SoundManager::loadSound(const char* path) {
-   return std::shared_ptr<Mix_Chunk>(Mix_LoadWAV(path), Mix_FreeChunk);
-}
+void SoundManager::playSound(SoundID sound) {
+   const SoundSettings& settings = SOUND_SETTINGS[(int)sound];
+
+   if (tick < cooldownEnds[(int)sound]) {
+      limitedCount++;
+      return;
+   }
+
+   // Loaded first, so a sound that can't be loaded doesn't cut off another one for nothing
+   AudioData data = getSound(sound);
+   if (!data) {
+      droppedCount++;
+      return;
+   }
+
+   int channel = findChannel(settings);
+   if (channel < 0) {
+      droppedCount++;
+      return;
+   }
+
+   if (backend->isPlaying(channel)) {
+      backend->haltSound(channel);
+      stolenCount++;
+   }
+
+   if (!backend->playSound(channel, data)) {
+      droppedCount++;
+      return;
+   }
 
-std::shared_ptr<Mix_Music> SoundManager::loadMusic(const char* path) {
-   return std::shared_ptr<Mix_Music>(Mix_LoadMUS(path), Mix_FreeMusic);
+   voices[channel] = Voice{sound, settings.priority, tick};
+   cooldownEnds[(int)sound] = tick + settings.cooldownTicks;
 }
 
-void SoundManager::playSound(SoundID sound) {
-   auto* chunk = sounds.at(sound).get();
-   Mix_PlayChannel(-1, chunk, 0);
+int SoundManager::findChannel(const SoundSettings& settings) {
+   int stealable = -1;
+
+   for (int channel = 0; channel < (int)voices.size(); channel++) {
+      if (!backend->isPlaying(channel)) {
+         return channel;
+      }
+
+      const Voice& voice = voices[channel];
+
+      bool canSteal =
+          (settings.steal == StealPolicy::LOWER && voice.priority < settings.priority) ||
+          (settings.steal == StealPolicy::LOWER_OR_EQUAL && voice.priority <= settings.priority);
+
+      // The least important voice is taken, and the oldest of those
+      if (canSteal && (stealable < 0 || voice.priority < voices[stealable].priority ||
+                       (voice.priority == voices[stealable].priority &&
+                        voice.startTick < voices[stealable].startTick))) {
+         stealable = channel;
+      }
+   }
+
+   return stealable;
 }
 
 void SoundManager::playMusic(MusicID music) {
    stopMusic();
-   Mix_PlayMusic(musics.at(music).get(), -1);
+
+   AudioData data = getMusic(music);
+   if (!data) {
+      return;
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      currentMusic = (int)music;
+   }
+
+   backend->playMusic(data);
 }
 
 void SoundManager::pauseSounds() {
-   Mix_Pause(0);
-   Mix_Pause(1);
-   Mix_Pause(2);
-   Mix_Pause(3);
+   backend->pauseSounds();
 }
 
 void SoundManager::resumeSounds() {
-   Mix_Resume(0);
-   Mix_Resume(1);
-   Mix_Resume(2);
-   Mix_Resume(3);
+   backend->resumeSounds();
 }
 
 void SoundManager::pauseMusic() {
-   Mix_PauseMusic();
+   backend->pauseMusic();
 }
 
 void SoundManager::resumeMusic() {
-   Mix_ResumeMusic();
+   backend->resumeMusic();
 }
 
 void SoundManager::stopMusic() {
-   Mix_HaltMusic();
-}
-
-void SoundManager::loadSounds() {
-   sounds.insert({SoundID::BLOCK_BREAK, loadSound("res/sounds/effects/blockbreak.wav")});
-   sounds.insert({SoundID::BLOCK_HIT, loadSound("res/sounds/effects/blockhit.wav")});
-   sounds.insert({SoundID::BOWSER_FALL, loadSound("res/sounds/effects/bowserfall.wav")});
-   sounds.insert({SoundID::BOWSER_FIRE, loadSound("res/sounds/effects/bowserfire.wav")});
-   sounds.insert({SoundID::CANNON_FIRE, loadSound("res/sounds/effects/cannonfire.wav")});
-   sounds.insert({SoundID::CASTLE_CLEAR, loadSound("res/sounds/effects/castleclear.wav")});
-   sounds.insert({SoundID::COIN, loadSound("res/sounds/effects/coin.wav")});
-   sounds.insert({SoundID::DEATH, loadSound("res/sounds/effects/death.wav")});
-   sounds.insert({SoundID::FIREBALL, loadSound("res/sounds/effects/fireball.wav")});
-   sounds.insert({SoundID::FLAG_RAISE, loadSound("res/sounds/effects/flagraise.wav")});
-   sounds.insert({SoundID::GAME_OVER, loadSound("res/sounds/effects/gameover.wav")});
-   sounds.insert({SoundID::JUMP, loadSound("res/sounds/effects/jump.wav")});
-   sounds.insert({SoundID::KICK, loadSound("res/sounds/effects/kick.wav")});
-   sounds.insert({SoundID::ONE_UP, loadSound("res/sounds/effects/oneup.wav")});
-   sounds.insert({SoundID::PAUSE, loadSound("res/sounds/effects/pause.wav")});
-   sounds.insert({SoundID::PIPE, loadSound("res/sounds/effects/pipe.wav")});
-   sounds.insert({SoundID::POWER_UP_APPEAR, loadSound("res/sounds/effects/powerupappear.wav")});
-   sounds.insert({SoundID::POWER_UP_COLLECT, loadSound("res/sounds/effects/powerupcollect.wav")});
-   sounds.insert({SoundID::SHRINK, loadSound("res/sounds/effects/shrink.wav")});
-   sounds.insert({SoundID::STOMP, loadSound("res/sounds/effects/stomp.wav")});
-   sounds.insert({SoundID::TIMER_TICK, loadSound("res/sounds/effects/timertick.wav")});
-}
-
-void SoundManager::loadMusics() {
-   musics.insert({MusicID::OVERWORLD, loadMusic("res/sounds/music/overworld.wav")});
-   musics.insert({MusicID::UNDERGROUND, loadMusic("res/sounds/music/underground.wav")});
-   musics.insert({MusicID::CASTLE, loadMusic("res/sounds/music/castle.wav")});
-   musics.insert({MusicID::UNDERWATER, loadMusic("res/sounds/music/underwater.wav")});
-   musics.insert({MusicID::SUPER_STAR, loadMusic("res/sounds/music/superstar.wav")});
-   musics.insert({MusicID::GAME_WON, loadMusic("res/sounds/music/gamewon.wav")});
+   backend->haltMusic();
+
+   std::lock_guard<std::mutex> lock(mutex);
+   currentMusic = -1;
+}
+
+void SoundManager::nextTick() {
+   backend->advanceTick();
+   tick++;
+}
+
+void SoundManager::preloadSound(SoundID sound) {
+#ifdef __EMSCRIPTEN__
+   // Without threads the sound is loaded when it is first played
+   return;
+#endif
+
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      const AudioFile& file = sounds[(int)sound];
+      if (file.data || file.loading || file.failed) {
+         return;
+      }
+
+      preloadRequests.push_back(PreloadRequest{false, (int)sound});
+
+      if (!preloadThread.joinable()) {
+         preloadThread = std::thread(&SoundManager::runPreloader, this);
+      }
+   }
+   condition.notify_all();
+}
+
+void SoundManager::preloadMusic(MusicID music) {
+#ifdef __EMSCRIPTEN__
+   return;
+#endif
+
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      AudioFile& file = musics[(int)music];
+
+      // Counts as a use, so the music isn't the first to be let go of before it plays
+      file.lastUsed = ++useCount;
+
+      if (file.data || file.loading || file.failed) {
+         return;
+      }
+
+      preloadRequests.push_back(PreloadRequest{true, (int)music});
+
+      if (!preloadThread.joinable()) {
+         preloadThread = std::thread(&SoundManager::runPreloader, this);
+      }
+   }
+   condition.notify_all();
+}
+
+void SoundManager::printLoadReport() {
+   std::lock_guard<std::mutex> lock(mutex);
+
+   std::cout << "Audio files: " << loadCount << " loaded in " << loadMilliseconds << " ms, "
+             << loadedBytes / 1024 << " KB held (" << peakBytes / 1024 << " KB at the peak), "
+             << evictedCount << " music let go of" << std::endl;
+}
+
+AudioData SoundManager::getSound(SoundID sound) {
+   std::unique_lock<std::mutex> lock(mutex);
+
+   AudioFile& file = sounds[(int)sound];
+
+   loadFile(lock, file, [this, sound]() {
+      return loadSoundFile(sound);
+   });
+
+   return file.data;
+}
+
+AudioData SoundManager::getMusic(MusicID music) {
+   std::unique_lock<std::mutex> lock(mutex);
+
+   AudioFile& file = musics[(int)music];
+   file.lastUsed = ++useCount;
+
+   loadFile(lock, file, [this, music]() {
+      return loadMusicFile(music);
+   });
+   evictMusic((int)music);
+
+   return file.data;
+}
+
+AudioData SoundManager::loadSoundFile(SoundID sound) {
+   const char* path = SOUND_PATHS[(int)sound];
+
+   AudioData data = backend->loadSound(path);
+   if (!data) {
+      std::cerr << "Failed to Load Sound " << path << ": " << backend->getError() << std::endl;
+   }
+
+   return data;
+}
+
+AudioData SoundManager::loadMusicFile(MusicID music) {
+   const char* path = MUSIC_PATHS[(int)music];
+
+   AudioData data = backend->loadMusic(path);
+   if (!data) {
+      std::cerr << "Failed to Load Music " << path << ": " << backend->getError() << std::endl;
+   }
+
+   return data;
+}
+
+template <typename Loader>
+void SoundManager::loadFile(std::unique_lock<std::mutex>& lock, AudioFile& file, Loader load) {
+   // Finishing the load that the background thread started is quicker than starting over
+   condition.wait(lock, [&file]() {
+      return !file.loading;
+   });
+
+   if (file.data || file.failed) {
+      return;
+   }
+
+   file.loading = true;
+   lock.unlock();
+
+   auto startTime = std::chrono::steady_clock::now();
+   AudioData data = load();
+   double milliseconds =
+       std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime)
+           .count();
+
+   lock.lock();
+
+   file.loading = false;
+   loadMilliseconds += milliseconds;
+
+   if (!data) {
+      file.failed = true;
+   } else {
+      file.data = data;
+      file.bytes = data.bytes;
+
+      loadCount++;
+      loadedBytes += data.bytes;
+      peakBytes = std::max(peakBytes, loadedBytes);
+   }
+
+   condition.notify_all();
+}
+
+void SoundManager::evictMusic(int keptMusic) {
+   std::size_t musicBytes = 0;
+   for (const AudioFile& file : musics) {
+      musicBytes += file.bytes;
+   }
+
+   while (musicBytes > musicBudget) {
+      int leastRecent = -1;
+
+      for (int music = 0; music < (int)musics.size(); music++) {
+         if (!musics[music].data || music == keptMusic || music == currentMusic) {
+            continue;
+         }
+         if (leastRecent < 0 || musics[music].lastUsed < musics[leastRecent].lastUsed) {
+            leastRecent = music;
+         }
+      }
+
+      if (leastRecent < 0) {
+         return;
+      }
+
+      AudioFile& file = musics[leastRecent];
+      musicBytes -= file.bytes;
+      loadedBytes -= file.bytes;
+      file.data = AudioData{};
+      file.bytes = 0;
+
+      evictedCount++;
+   }
+}
+
+void SoundManager::stopPreloader() {
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+      preloadRequests.clear();
+   }
+   condition.notify_all();
+
+   if (preloadThread.joinable()) {
+      preloadThread.join();
+   }
+}
+
+void SoundManager::runPreloader() {
+   std::unique_lock<std::mutex> lock(mutex);
+
+   while (true) {
+      condition.wait(lock, [this]() {
+         return stopping || !preloadRequests.empty();
+      });
+
+      if (stopping) {
+         return;
+      }
+
+      PreloadRequest request = preloadRequests.front();
+      preloadRequests.pop_front();
+
+      if (request.music) {
+         loadFile(lock, musics[request.id], [this, request]() {
+            return loadMusicFile((MusicID)request.id);
+         });
+         evictMusic(request.id);
+      } else {
+         loadFile(lock, sounds[request.id], [this, request]() {
+            return loadSoundFile((SoundID)request.id);
+         });
+      }
+   }
 }
@@ -0,0 +1,333 @@
+#include "TextureAtlas.h"
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+int TextureAtlas::build(SDL_Renderer* renderer, const std::string& spriteDirectory,
+                        const std::string& cacheDirectory) {
+   clear();
+
+   Uint32 startTime = SDL_GetTicks();
+
+   std::vector<Entry> sprites = findSprites(spriteDirectory);
+   if (sprites.empty()) {
+      std::cerr << "Failed to find any Sprites in " << spriteDirectory << std::endl;
+      return -1;
+   }
+
+   bool cached = loadCache(renderer, cacheDirectory, sprites);
+
+   if (!cached && pack(renderer, cacheDirectory, sprites) != 0) {
+      clear();
+      return -1;
+   }
+
+   for (Entry& sprite : sprites) {
+      if (sprite.page >= 0) {
+         entries.insert({sprite.path, sprite});
+      }
+   }
+
+   std::cout << (cached ? "Loaded " : "Packed ") << entries.size() << " sprites onto "
+             << pages.size() << " atlas page(s) in " << SDL_GetTicks() - startTime << " ms"
+             << std::endl;
+
+   return 0;
+}
+
+void TextureAtlas::clear() {
+   entries.clear();
+   pages.clear();
+}
+
+std::shared_ptr<SDL_Texture> TextureAtlas::getSheet(const std::string& path, bool blueTransparent) {
+   auto it = entries.find(path);
+   if (it == entries.end()) {
+      return nullptr;
+   }
+
+   const Entry& entry = it->second;
+
+   // The key color was made transparent when the sheet was packed
+   if (entry.keyed && !blueTransparent) {
+      return nullptr;
+   }
+
+   const std::shared_ptr<SDL_Texture>& page = pages[entry.page];
+
+   return std::shared_ptr<SDL_Texture>(page.get(), AtlasRegion{page, entry.area});
+}
+
+std::vector<TextureAtlas::Entry> TextureAtlas::findSprites(const std::string& spriteDirectory) {
+   std::vector<Entry> sprites;
+
+   std::error_code error;
+   for (auto it = std::filesystem::recursive_directory_iterator(spriteDirectory, error);
+        it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+      if (error) {
+         break;
+      }
+      if (!it->is_regular_file() || it->path().extension() != ".png") {
+         continue;
+      }
+
+      Entry sprite{};
+      sprite.path = it->path().generic_string();
+      sprite.fileSize = it->file_size();
+      sprite.modifiedTime = it->last_write_time().time_since_epoch().count();
+      sprite.page = -1;
+
+      sprites.push_back(sprite);
+   }
+
+   // Sorted so the sprites line up with the cached layout
+   std::sort(sprites.begin(), sprites.end(), [](const Entry& a, const Entry& b) {
+      return a.path < b.path;
+   });
+
+   return sprites;
+}
+
+bool TextureAtlas::loadCache(SDL_Renderer* renderer, const std::string& cacheDirectory,
+                             std::vector<Entry>& sprites) {
+   std::ifstream layoutFile(cacheDirectory + "/atlas.layout");
+   if (!layoutFile) {
+      return false;
+   }
+
+   std::string header;
+   int version, pageCount;
+   std::size_t spriteCount;
+
+   if (!(layoutFile >> header >> version >> pageCount >> spriteCount) || header != "atlas" ||
+       version != LAYOUT_VERSION || spriteCount != sprites.size()) {
+      return false;
+   }
+
+   for (Entry& sprite : sprites) {
+      Entry cached{};
+
+      layoutFile >> cached.page >> cached.area.x >> cached.area.y >> cached.area.w >>
+          cached.area.h >> cached.keyed >> cached.fileSize >> cached.modifiedTime >> std::ws;
+      std::getline(layoutFile, cached.path);
+
+      // Any sprite that was added, removed or changed means the atlas has to be packed again
+      if (!layoutFile || cached.path != sprite.path || cached.fileSize != sprite.fileSize ||
+          cached.modifiedTime != sprite.modifiedTime || cached.page >= pageCount) {
+         return false;
+      }
+
+      sprite.page = cached.page;
+      sprite.area = cached.area;
+      sprite.keyed = cached.keyed;
+   }
+
+   for (int page = 0; page < pageCount; page++) {
+      SDL_Surface* surface =
+          IMG_Load((cacheDirectory + "/atlas" + std::to_string(page) + ".png").c_str());
+      if (!surface) {
+         pages.clear();
+         return false;
+      }
+
+      bool added = addPage(renderer, surface);
+
+      SDL_FreeSurface(surface);
+
+      if (!added) {
+         pages.clear();
+         return false;
+      }
+   }
+
+   return true;
+}
+
+int TextureAtlas::pack(SDL_Renderer* renderer, const std::string& cacheDirectory,
+                       std::vector<Entry>& sprites) {
+   std::vector<SDL_Surface*> surfaces(sprites.size(), nullptr);
+
+   for (std::size_t i = 0; i < sprites.size(); i++) {
+      sprites[i].page = -1;
+
+      SDL_Surface* loadedSurface = IMG_Load(sprites[i].path.c_str());
+      if (!loadedSurface) {
+         std::cerr << "Failed to Load Sprite " << sprites[i].path << ": " << SDL_GetError()
+                   << std::endl;
+         continue;
+      }
+
+      surfaces[i] = SDL_ConvertSurfaceFormat(loadedSurface, SDL_PIXELFORMAT_RGBA32, 0);
+
+      SDL_FreeSurface(loadedSurface);
+
+      // Sprites that don't fit on a page are loaded as their own texture instead
+      if (surfaces[i] && (surfaces[i]->w > PAGE_SIZE || surfaces[i]->h > PAGE_SIZE)) {
+         SDL_FreeSurface(surfaces[i]);
+         surfaces[i] = nullptr;
+      }
+
+      if (surfaces[i]) {
+         sprites[i].keyed = applyColorKey(surfaces[i]);
+      }
+   }
+
+   // Shelf packing, the tallest sprites go first so the shelves waste as little space as possible
+   std::vector<std::size_t> packOrder;
+   for (std::size_t i = 0; i < sprites.size(); i++) {
+      if (surfaces[i]) {
+         packOrder.push_back(i);
+      }
+   }
+   std::stable_sort(packOrder.begin(), packOrder.end(), [&](std::size_t a, std::size_t b) {
+      return surfaces[a]->h > surfaces[b]->h;
+   });
+
+   std::vector<int> pageHeights;
+   int shelfX = 0;
+   int shelfY = 0;
+   int shelfHeight = 0;
+
+   for (std::size_t i : packOrder) {
+      SDL_Surface* surface = surfaces[i];
+
+      if (shelfX + surface->w > PAGE_SIZE) {
+         shelfX = 0;
+         shelfY += shelfHeight + PADDING;
+         shelfHeight = 0;
+      }
+      if (pageHeights.empty() || shelfY + surface->h > PAGE_SIZE) {
+         pageHeights.push_back(0);
+         shelfX = 0;
+         shelfY = 0;
+         shelfHeight = 0;
+      }
+
+      sprites[i].page = (int)pageHeights.size() - 1;
+      sprites[i].area = SDL_Rect{shelfX, shelfY, surface->w, surface->h};
+
+      shelfX += surface->w + PADDING;
+      shelfHeight = std::max(shelfHeight, surface->h);
+      pageHeights.back() = std::max(pageHeights.back(), shelfY + surface->h);
+   }
+
+   // Pages are only as tall as their contents
+   std::vector<SDL_Surface*> pageSurfaces;
+   for (int pageHeight : pageHeights) {
+      pageSurfaces.push_back(
+          SDL_CreateRGBSurfaceWithFormat(0, PAGE_SIZE, pageHeight, 32, SDL_PIXELFORMAT_RGBA32));
+   }
+
+   int result = 0;
+
+   for (std::size_t i : packOrder) {
+      SDL_Surface* pageSurface = pageSurfaces[sprites[i].page];
+
+      if (pageSurface) {
+         // Copies the alpha channel as it is, instead of blending onto the empty page
+         SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+
+         SDL_Rect destinationRect = sprites[i].area;
+         SDL_BlitSurface(surfaces[i], nullptr, pageSurface, &destinationRect);
+      }
+
+      SDL_FreeSurface(surfaces[i]);
+   }
+
+   for (SDL_Surface* pageSurface : pageSurfaces) {
+      if (!pageSurface || !addPage(renderer, pageSurface)) {
+         std::cerr << "Failed to Create Atlas Page: " << SDL_GetError() << std::endl;
+         result = -1;
+         break;
+      }
+   }
+
+   if (result == 0) {
+      saveCache(cacheDirectory, sprites, pageSurfaces);
+   }
+
+   for (SDL_Surface* pageSurface : pageSurfaces) {
+      if (pageSurface) {
+         SDL_FreeSurface(pageSurface);
+      }
+   }
+
+   return result;
+}
+
+void TextureAtlas::saveCache(const std::string& cacheDirectory, const std::vector<Entry>& sprites,
+                             const std::vector<SDL_Surface*>& pageSurfaces) {
+   std::string layoutPath = cacheDirectory + "/atlas.layout";
+
+   std::error_code error;
+   std::filesystem::create_directories(cacheDirectory, error);
+
+   // The old layout can't be left behind pointing at the new pages if saving fails halfway
+   std::filesystem::remove(layoutPath, error);
+
+   if (error) {
+      std::cerr << "Failed to Create Atlas Cache: " << error.message() << std::endl;
+      return;
+   }
+
+   for (std::size_t page = 0; page < pageSurfaces.size(); page++) {
+      std::string pagePath = cacheDirectory + "/atlas" + std::to_string(page) + ".png";
+
+      if (IMG_SavePNG(pageSurfaces[page], pagePath.c_str()) != 0) {
+         std::cerr << "Failed to Save Atlas Page " << pagePath << ": " << SDL_GetError()
+                   << std::endl;
+         return;
+      }
+   }
+
+   std::ofstream layoutFile(layoutPath);
+
+   layoutFile << "atlas " << LAYOUT_VERSION << " " << pageSurfaces.size() << " " << sprites.size()
+              << "\n";
+
+   for (const Entry& sprite : sprites) {
+      layoutFile << sprite.page << " " << sprite.area.x << " " << sprite.area.y << " "
+                 << sprite.area.w << " " << sprite.area.h << " " << sprite.keyed << " "
+                 << sprite.fileSize << " " << sprite.modifiedTime << " " << sprite.path << "\n";
+   }
+}
+
+bool TextureAtlas::addPage(SDL_Renderer* renderer, SDL_Surface* surface) {
+   SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+   if (!texture) {
+      return false;
+   }
+
+   SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+   pages.push_back(std::shared_ptr<SDL_Texture>(texture, SDL_DestroyTexture));
+
+   return true;
+}
+
+bool TextureAtlas::applyColorKey(SDL_Surface* surface) {
+   bool keyed = false;
+
+   SDL_LockSurface(surface);
+
+   // RGBA32 is always laid out as R, G, B, A bytes, whatever the endianness
+   for (int y = 0; y < surface->h; y++) {
+      Uint8* pixel = (Uint8*)surface->pixels + y * surface->pitch;
+
+      for (int x = 0; x < surface->w; x++, pixel += 4) {
+         if (pixel[0] == 147 && pixel[1] == 187 && pixel[2] == 236) {
+            pixel[3] = 0;
+            keyed = true;
+         }
+      }
+   }
+
+   SDL_UnlockSurface(surface);
+
+   return keyed;
+}
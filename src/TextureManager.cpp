@@ -10,11 +10,25 @@
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 
+#include <cmath>
+#include <future>
 #include <iostream>
 
 TextureManager TextureManager::instance;
 
-int TextureManager::Init() {
+int TextureManager::Init(bool headless, bool lowResolution) {
+   this->headless = headless;
+   this->lowResolution = lowResolution;
+
+   renderThreadID = std::this_thread::get_id();
+
+   if (headless) {
+      // Has to be set before SDL initializes the video and audio subsystems. The dummy audio
+      // driver discards its output, so the mixer still opens on machines without a sound card
+      SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+      SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+   }
+
    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_EVENTS | SDL_INIT_TIMER) != 0) {
       std::cerr << "Failed to Initialize SDL2: " << SDL_GetError() << std::endl;
       return -1;
@@ -28,6 +42,25 @@ int TextureManager::Init() {
       return -1;
    }
 
+   textFont = LoadSharedFont("res/fonts/press-start-2p.ttf", 25);
+
+   if (headless) {
+      offscreenSurface = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_WIDTH, SCREEN_HEIGHT, 32,
+                                                        SDL_PIXELFORMAT_RGBA32);
+      if (!offscreenSurface) {
+         std::cerr << "Failed to Create Offscreen Surface: " << SDL_GetError() << std::endl;
+         return -1;
+      }
+
+      renderer = SDL_CreateSoftwareRenderer(offscreenSurface);
+      if (!renderer) {
+         std::cerr << "Failed to Create Software Renderer: " << SDL_GetError() << std::endl;
+         return -1;
+      }
+
+      return SetupRenderer();
+   }
+
    window = SDL_CreateWindow("Super Mario Bros", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
                              SCREEN_WIDTH, SCREEN_HEIGHT,
                              SDL_WINDOW_SHOWN | SDL_WINDOW_ALLOW_HIGHDPI | SDL_WINDOW_RESIZABLE);
@@ -43,25 +76,80 @@ int TextureManager::Init() {
 
    SDL_FreeSurface(iconSurface);
 
-   renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+   renderer = SDL_CreateRenderer(window, -1,
+                                 SDL_RENDERER_ACCELERATED |
+                                     (lowResolution ? SDL_RENDERER_TARGETTEXTURE : 0));
    if (!renderer) {
       SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Failed to Create Renderer: %s", SDL_GetError());
       std::cerr << "Failed to Create Renderer: " << SDL_GetError() << std::endl;
       return -1;
    }
 
+   return SetupRenderer();
+}
+
+int TextureManager::SetupRenderer() {
    if (SDL_SetRenderDrawColor(renderer, 92, 148, 252, 255) != 0) {
       std::cerr << "Failed to set Draw Color: " << SDL_GetError() << std::endl;
    }
 
    SDL_RenderSetLogicalSize(renderer, SCREEN_WIDTH, SCREEN_HEIGHT);
 
+   if (lowResolution) {
+      worldTarget = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                      SCREEN_WIDTH / CUBE_SCALE_FACTOR,
+                                      SCREEN_HEIGHT / CUBE_SCALE_FACTOR);
+      if (!worldTarget) {
+         std::cerr << "Failed to Create World Render Target: " << SDL_GetError() << std::endl;
+         return -1;
+      }
+
+      // The world is only scaled up once, and should keep its hard pixel edges
+      SDL_SetTextureScaleMode(worldTarget, SDL_ScaleModeNearest);
+   }
+
+   // Without the atlas every sheet is just loaded as its own texture
+   if (textureAtlas.build(renderer, "res/sprites", "res/cache") != 0) {
+      std::cerr << "Failed to Build Texture Atlas, loading Sprites separately" << std::endl;
+   }
+
    return 0;
 }
 
+int TextureManager::StartCapture(CaptureFormat format, const std::string& path, int interval) {
+   int outputWidth, outputHeight;
+   if (SDL_GetRendererOutputSize(renderer, &outputWidth, &outputHeight) != 0) {
+      std::cerr << "Failed to get Renderer Output Size: " << SDL_GetError() << std::endl;
+      return -1;
+   }
+
+   return frameCapture.start(format, path, interval, outputWidth, outputHeight);
+}
+
 int TextureManager::Quit() {
+   frameCapture.stop();
+
+   for (auto& [text, cachedText] : textCache) {
+      SDL_DestroyTexture(cachedText.texture);
+   }
+   textCache.clear();
+   textFont.reset();
+
+   textureAtlas.clear();
+
+   if (worldTarget) {
+      SDL_DestroyTexture(worldTarget);
+      worldTarget = nullptr;
+   }
+
    SDL_DestroyRenderer(renderer);
-   SDL_DestroyWindow(window);
+
+   if (window) {
+      SDL_DestroyWindow(window);
+   }
+   if (offscreenSurface) {
+      SDL_FreeSurface(offscreenSurface);
+   }
 
    IMG_Quit();
    SDL_Quit();
@@ -78,14 +166,25 @@ SDL_Texture* TextureManager::LoadTexture(const char* path) {
 
 std::shared_ptr<SDL_Texture> TextureManager::LoadSharedTexture(const char* path,
                                                                bool blueTransparent) {
+   if (std::shared_ptr<SDL_Texture> sheet = textureAtlas.getSheet(path, blueTransparent)) {
+      return sheet;
+   }
+
    SDL_Surface* surface = IMG_Load(path);
    if (blueTransparent) {
       SDL_SetColorKey(surface, SDL_TRUE, SDL_MapRGB(surface->format, 147, 187, 236));
    }
-   std::shared_ptr<SDL_Texture> texture(SDL_CreateTextureFromSurface(renderer, surface),
-                                        SDL_DestroyTexture);
+
+   SDL_Texture* texture = nullptr;
+   RunOnRenderThread([&]() {
+      texture = SDL_CreateTextureFromSurface(renderer, surface);
+   });
+
    SDL_FreeSurface(surface);
-   return texture;
+
+   return std::shared_ptr<SDL_Texture>(texture, [](SDL_Texture* texture) {
+      TextureManager::Get().DestroyTexture(texture);
+   });
 }
 
 std::shared_ptr<TTF_Font> TextureManager::LoadSharedFont(const char* path, int fontSize) {
@@ -100,7 +199,7 @@ void TextureManager::Draw(SDL_Texture* texture, SDL_Rect sourceRect, SDL_Rect de
    SDL_RenderCopy(renderer, texture, &sourceRect, &destRect);
 }
 
-void TextureManager::Draw(std::shared_ptr<SDL_Texture> texture, SDL_Rect sourceRect,
+void TextureManager::Draw(const std::shared_ptr<SDL_Texture>& texture, SDL_Rect sourceRect,
                           SDL_Rect destRect, bool horizontal, bool vertical) {
    if (!horizontal && !vertical) {
       SDL_RenderCopyEx(renderer, texture.get(), &sourceRect, &destRect, 0, nullptr, SDL_FLIP_NONE);
@@ -133,6 +232,25 @@ void TextureManager::Draw(std::shared_ptr<TTF_Font> font, const char* text, SDL_
    SDL_DestroyTexture(texture);
 }
 
+void TextureManager::DrawText(const std::string& text, SDL_Rect position) {
+   auto it = textCache.find(text);
+
+   if (it == textCache.end()) {
+      SDL_Color color = {255, 255, 255, 255};
+      SDL_Surface* textSurface = TTF_RenderText_Blended(textFont.get(), text.c_str(), color);
+
+      SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, textSurface);
+
+      SDL_FreeSurface(textSurface);
+
+      it = textCache.insert({text, CachedText{texture, drawnFrames}}).first;
+   }
+
+   it->second.lastUsedFrame = drawnFrames;
+
+   SDL_RenderCopy(renderer, it->second.texture, nullptr, &position);
+}
+
 void TextureManager::DrawHorizontalFlipped(std::shared_ptr<SDL_Texture> texture,
                                            SDL_Rect sourceRect, SDL_Rect destRect) {
    SDL_RenderCopyEx(renderer, texture.get(), &sourceRect, &destRect, 0, nullptr,
@@ -144,26 +262,17 @@ void TextureManager::DrawVerticalFlipped(std::shared_ptr<SDL_Texture> texture, S
    SDL_RenderCopyEx(renderer, texture.get(), &sourceRect, &destRect, 0, nullptr, SDL_FLIP_VERTICAL);
 }
 
+// The color is only recorded here, it gets drawn with the next snapshot
 void TextureManager::SetBackgroundColor(BackgroundColor color) {
-   switch (color) {
-      case BackgroundColor::BLUE:
-         SDL_SetRenderDrawColor(renderer, 92, 148, 252, 255);
-         break;
-      case BackgroundColor::BLACK:
-         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-         break;
-      default:
-         break;
-   }
    currentColor = color;
 }
 
-void TextureManager::Clear() {
+void TextureManager::Clear(BackgroundColor color) {
    // Creates black borders
    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
    SDL_RenderClear(renderer);
 
-   switch (currentColor) {
+   switch (color) {
       case BackgroundColor::BLUE:
          SDL_SetRenderDrawColor(renderer, 92, 148, 252, 255);
          break;
@@ -180,15 +289,163 @@ void TextureManager::Clear() {
 }
 
 void TextureManager::Display() {
+   // The contents of the renderer are undefined after presenting, so the frame is copied first
+   frameCapture.captureFrame(renderer);
+
    SDL_RenderPresent(renderer);
 }
 
+RenderSnapshot& TextureManager::BeginSnapshot() {
+   RenderSnapshot& snapshot = snapshotBuffer.getWriteSnapshot();
+   snapshot.clear();
+   return snapshot;
+}
+
+void TextureManager::PublishSnapshot() {
+   snapshotBuffer.publish();
+}
+
+bool TextureManager::DrawLatestSnapshot() {
+   const RenderSnapshot* snapshot = snapshotBuffer.acquireLatest();
+
+   if (!snapshot) {
+      return false;
+   }
+
+   if (lowResolution) {
+      DrawLowResolution(*snapshot);
+   } else {
+      Clear(snapshot->backgroundColor);
+
+      // Text is drawn in between the sprites, in the same order the RenderSystem found it
+      std::size_t sprite = 0;
+      for (const TextDrawCommand& text : snapshot->texts) {
+         for (; sprite < text.spritesBefore; sprite++) {
+            const SpriteDrawCommand& command = snapshot->sprites[sprite];
+            Draw(command.texture, command.sourceRect, command.destinationRect,
+                 command.horizontalFlipped, command.verticalFlipped);
+         }
+         DrawText(text.text, text.destinationRect);
+      }
+      for (; sprite < snapshot->sprites.size(); sprite++) {
+         const SpriteDrawCommand& command = snapshot->sprites[sprite];
+         Draw(command.texture, command.sourceRect, command.destinationRect,
+              command.horizontalFlipped, command.verticalFlipped);
+      }
+   }
+
+   Display();
+
+   drawnFrames++;
+
+   if (drawnFrames % TEXT_CACHE_LIFETIME == 0) {
+      EvictUnusedText();
+   }
+
+   return true;
+}
+
+void TextureManager::DrawLowResolution(const RenderSnapshot& snapshot) {
+   // Snapshots are recorded in screen coordinates, which are CUBE_SCALE_FACTOR times the size of
+   // the world target. Converting both edges keeps neighbouring sprites from leaving gaps
+   auto toWorldPixels = [](int screenPixels) {
+      return (int)std::floor((float)screenPixels / CUBE_SCALE_FACTOR);
+   };
+
+   SDL_SetRenderTarget(renderer, worldTarget);
+
+   Clear(snapshot.backgroundColor);
+
+   for (const SpriteDrawCommand& command : snapshot.sprites) {
+      const SDL_Rect& screenRect = command.destinationRect;
+
+      int left = toWorldPixels(screenRect.x);
+      int top = toWorldPixels(screenRect.y);
+      SDL_Rect worldRect{left, top, toWorldPixels(screenRect.x + screenRect.w) - left,
+                         toWorldPixels(screenRect.y + screenRect.h) - top};
+
+      Draw(command.texture, command.sourceRect, worldRect, command.horizontalFlipped,
+           command.verticalFlipped);
+   }
+
+   SDL_SetRenderTarget(renderer, nullptr);
+
+   // Creates black borders
+   SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+   SDL_RenderClear(renderer);
+
+   SDL_Rect screenRect{0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
+   SDL_RenderCopy(renderer, worldTarget, nullptr, &screenRect);
+
+   // Text goes on top at the full resolution, so it stays sharp
+   for (const TextDrawCommand& text : snapshot.texts) {
+      DrawText(text.text, text.destinationRect);
+   }
+}
+
+void TextureManager::EvictUnusedText() {
+   for (auto it = textCache.begin(); it != textCache.end();) {
+      if (drawnFrames - it->second.lastUsedFrame > TEXT_CACHE_LIFETIME) {
+         SDL_DestroyTexture(it->second.texture);
+         it = textCache.erase(it);
+      } else {
+         it++;
+      }
+   }
+}
+
+void TextureManager::RunOnRenderThread(const std::function<void()>& task) {
+   if (onRenderThread()) {
+      task();
+      return;
+   }
+
+   std::promise<void> taskDone;
+   std::future<void> taskFinished = taskDone.get_future();
+   {
+      std::lock_guard<std::mutex> lock(renderTaskMutex);
+      renderTasks.push_back([&]() {
+         task();
+         taskDone.set_value();
+      });
+   }
+   taskFinished.wait();
+}
+
+void TextureManager::RunRenderTasks() {
+   std::vector<std::function<void()>> tasks;
+   {
+      std::lock_guard<std::mutex> lock(renderTaskMutex);
+      tasks.swap(renderTasks);
+   }
+
+   for (auto& task : tasks) {
+      task();
+   }
+}
+
+void TextureManager::DestroyTexture(SDL_Texture* texture) {
+   if (onRenderThread()) {
+      SDL_DestroyTexture(texture);
+      return;
+   }
+
+   // Textures are released by the simulation thread when entities are destroyed
+   std::lock_guard<std::mutex> lock(renderTaskMutex);
+   renderTasks.push_back([texture]() {
+      SDL_DestroyTexture(texture);
+   });
+}
+
 #ifdef __EMSCRIPTEN__
 EM_JS(int, get_canvas_width, (), { return canvas.width; });
 EM_JS(int, get_canvas_height, (), { return canvas.height; });
 #endif
 
 void TextureManager::ResizeWindow() {
+   if (headless) {
+      return;
+   }
 #ifdef __EMSCRIPTEN__
    int windowWidth = get_canvas_width();
    int windowHeight = get_canvas_height();
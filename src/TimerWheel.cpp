@@ -0,0 +1,135 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+TimerWheel::Timer::~Timer() {
+   if (wheel != nullptr) {
+      wheel->cancel(this);
+   }
+}
+
+TimerWheel::~TimerWheel() {
+   for (Slot& slot : nearSlots) {
+      release(slot);
+   }
+   for (Slot& slot : farSlots) {
+      release(slot);
+   }
+   release(expired);
+}
+
+void TimerWheel::schedule(Timer* timer, int ticks) {
+   std::lock_guard<std::mutex> lock(mutex);
+
+   if (timer->isScheduled()) {
+      unlink(timer);
+      scheduledCount--;
+   }
+   if (timer == expiring) {
+      expiring = nullptr;
+   }
+
+   timer->wheel = this;
+   timer->expiry = tick + std::max(ticks, 1);
+
+   insert(timer);
+   scheduledCount++;
+}
+
+void TimerWheel::cancel(Timer* timer) {
+   std::lock_guard<std::mutex> lock(mutex);
+
+   if (timer->isScheduled()) {
+      unlink(timer);
+      scheduledCount--;
+   }
+   if (timer == expiring) {
+      expiring = nullptr;
+   }
+}
+
+void TimerWheel::advance() {
+   std::lock_guard<std::mutex> lock(mutex);
+
+   tick++;
+
+   // A new block of ticks starts, so its timers are spread over the near slots
+   if ((tick & (NEAR_SLOTS - 1)) == 0) {
+      Slot& farSlot = farSlots[(tick >> NEAR_BITS) % FAR_SLOTS];
+
+      while (farSlot.sentinel.next != &farSlot.sentinel) {
+         Timer* timer = farSlot.sentinel.next;
+         unlink(timer);
+         insert(timer);
+      }
+   }
+
+   Slot& nearSlot = nearSlots[tick & (NEAR_SLOTS - 1)];
+
+   while (nearSlot.sentinel.next != &nearSlot.sentinel) {
+      Timer* timer = nearSlot.sentinel.next;
+      unlink(timer);
+      link(expired, timer);
+   }
+}
+
+TimerWheel::Timer* TimerWheel::popExpired() {
+   std::lock_guard<std::mutex> lock(mutex);
+
+   Timer* timer = expired.sentinel.next;
+   if (timer == &expired.sentinel) {
+      expiring = nullptr;
+      return nullptr;
+   }
+
+   unlink(timer);
+   scheduledCount--;
+
+   expiring = timer;
+   return timer;
+}
+
+bool TimerWheel::isExpiring(const Timer* timer) const {
+   std::lock_guard<std::mutex> lock(mutex);
+
+   return timer == expiring;
+}
+
+void TimerWheel::insert(Timer* timer) {
+   uint64_t ticksLeft = timer->expiry - tick;
+
+   if (ticksLeft < NEAR_SLOTS) {
+      link(nearSlots[timer->expiry & (NEAR_SLOTS - 1)], timer);
+      return;
+   }
+
+   // Timers past the last block wait in it, and are placed again when it starts
+   uint64_t blocksLeft = (timer->expiry >> NEAR_BITS) - (tick >> NEAR_BITS);
+   uint64_t block = (tick >> NEAR_BITS) + std::min<uint64_t>(blocksLeft, FAR_SLOTS - 1);
+
+   link(farSlots[block % FAR_SLOTS], timer);
+}
+
+void TimerWheel::link(Slot& slot, Timer* timer) {
+   timer->previous = slot.sentinel.previous;
+   timer->next = &slot.sentinel;
+
+   slot.sentinel.previous->next = timer;
+   slot.sentinel.previous = timer;
+}
+
+void TimerWheel::unlink(Timer* timer) {
+   timer->previous->next = timer->next;
+   timer->next->previous = timer->previous;
+
+   timer->previous = nullptr;
+   timer->next = nullptr;
+}
+
+void TimerWheel::release(Slot& slot) {
+   while (slot.sentinel.next != &slot.sentinel) {
+      Timer* timer = slot.sentinel.next;
+      unlink(timer);
+      timer->wheel = nullptr;
+   }
+}
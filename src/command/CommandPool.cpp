@@ -0,0 +1,66 @@
+#include "command/CommandPool.h"
+
+#include <algorithm>
+#include <new>
+
+CommandPool::~CommandPool() {
+   for (void* chunk : chunks) {
+      ::operator delete(chunk);
+   }
+}
+
+void* CommandPool::allocate(std::size_t size) {
+   std::lock_guard<std::mutex> lock(mutex);
+
+   liveCount++;
+   peakCount = std::max(peakCount, liveCount);
+
+   if (size == 0 || size > MAX_SLOT_SIZE) {
+      return ::operator new(size);
+   }
+
+   std::size_t sizeClass = getSizeClass(size);
+
+   if (freeSlots[sizeClass] == nullptr) {
+      allocateChunk(sizeClass);
+   }
+
+   FreeSlot* slot = freeSlots[sizeClass];
+   freeSlots[sizeClass] = slot->next;
+
+   return slot;
+}
+
+void CommandPool::release(void* memory, std::size_t size) {
+   if (memory == nullptr) {
+      return;
+   }
+
+   std::lock_guard<std::mutex> lock(mutex);
+
+   liveCount--;
+
+   if (size == 0 || size > MAX_SLOT_SIZE) {
+      ::operator delete(memory);
+      return;
+   }
+
+   std::size_t sizeClass = getSizeClass(size);
+
+   FreeSlot* slot = static_cast<FreeSlot*>(memory);
+   slot->next = freeSlots[sizeClass];
+   freeSlots[sizeClass] = slot;
+}
+
+void CommandPool::allocateChunk(std::size_t sizeClass) {
+   std::size_t slotSize = (sizeClass + 1) * SLOT_ALIGNMENT;
+
+   char* chunk = static_cast<char*>(::operator new(slotSize * SLOTS_PER_CHUNK));
+   chunks.push_back(chunk);
+
+   for (std::size_t i = SLOTS_PER_CHUNK; i > 0; i--) {
+      FreeSlot* slot = reinterpret_cast<FreeSlot*>(chunk + (i - 1) * slotSize);
+      slot->next = freeSlots[sizeClass];
+      freeSlots[sizeClass] = slot;
+   }
+}
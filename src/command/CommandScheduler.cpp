@@ -1,44 +1,47 @@
 #include "command/CommandScheduler.h"
 
-#include <algorithm>
-
 CommandScheduler CommandScheduler::instance;
 
 CommandScheduler& CommandScheduler::getInstance() {
    return instance;
 }
 
+CommandPool& CommandScheduler::getPool() {
+   return instance.pool;
+}
+
+void* Command::operator new(std::size_t size) {
+   return CommandScheduler::getPool().allocate(size);
+}
+
+void Command::operator delete(void* memory, std::size_t size) {
+   CommandScheduler::getPool().release(memory, size);
+}
+
 void CommandScheduler::addCommand(Command* command) {
-   commandQueue.emplace_back(std::move(command));
+   commandQueue.push_back(command);
 }
 
 void CommandScheduler::run() {
-   for (auto* command : commandQueue) {
+   // The queue can grow while the commands run, so it is indexed instead of iterated
+   std::size_t commandCount = commandQueue.size();
+   std::size_t keptCount = 0;
+
+   // Finished commands are removed in the same pass by moving the unfinished ones down, which
+   // keeps them in order without searching the queue for every finished command
+   for (std::size_t i = 0; i < commandCount; i++) {
+      Command* command = commandQueue[i];
+
       command->execute();
 
       if (command->isFinished()) {
-         destroyQueue.push_back(command);
+         delete command;
+         continue;
       }
-   }
-
-   emptyDestroyQueue();
-}
-
-void CommandScheduler::emptyDestroyQueue() {
-   if (destroyQueue.empty()) {
-      return;
-   }
-
-   for (Command* command : destroyQueue) {
-      commandQueue.erase(std::remove_if(commandQueue.begin(), commandQueue.end(),
-                                        [command](Command* other) {
-                                           return command == other;
-                                        }),
-                         commandQueue.end());
 
-      delete command;
+      commandQueue[keptCount++] = command;
    }
 
-   destroyQueue.clear();
-   commandQueue.shrink_to_fit();
+   // The commands that were added while running move up behind the ones that were kept
+   commandQueue.erase(commandQueue.begin() + keptCount, commandQueue.begin() + commandCount);
 }
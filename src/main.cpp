@@ -12,6 +12,8 @@ void runLoop(void* data) {
 int main(int argc, char** argv) {
    Core core;
 
+   core.parseArguments(argc, argv);
+
    if (core.init() != 0) {
       return -1;
    }
@@ -1,5 +1,6 @@
 #include "scenes/GameOverScene.h"
 
+#include "AudioQueue.h"
 #include "Camera.h"
 #include "Constants.h"
 #include "ECS/Components.h"
@@ -23,8 +24,7 @@ GameOverScene::GameOverScene() {
 
    gameOverText->addComponent<TextComponent>("GAME OVER", 20);
 
-   Entity* gameOverSound(world->create());
-   gameOverSound->addComponent<SoundComponent>(SoundID::GAME_OVER);
+   AudioQueue::Get().playSound(SoundID::GAME_OVER);
 }
 
 void GameOverScene::update() {
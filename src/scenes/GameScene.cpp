@@ -1,10 +1,13 @@
 #include "scenes/GameScene.h"
 
 #include "AABBCollision.h"
+#include "AudioQueue.h"
+#include "Camera.h"
 #include "Constants.h"
 #include "ECS/Components.h"
 #include "Input.h"
 #include "Level.h"
+#include "LevelPrefetcher.h"
 #include "Map.h"
 #include "SMBMath.h"
 #include "SoundManager.h"
@@ -14,29 +17,47 @@
 #include "systems/Systems.h"
 
 #include <algorithm>
-#include <fstream>
+#include <chrono>
 #include <iostream>
 #include <memory>
-#include <sstream>
 #include <string>
 #include <tuple>
 #include <vector>
 
-static int preloadEntities(void* data) {
-   MapSystem* mapSystem = (MapSystem*)data;
+// The level transition screen is shown for at least this long, even if the level loads sooner
+constexpr float MIN_TRANSITION_TIME = 2.0f;
 
-   mapSystem->loadEntities();
+bool GameScene::fixedTransitions = false;
 
-   return 0;
+// The names of the level layers in the order of LevelLayer, for the load report
+constexpr const char* LAYER_NAMES[(int)LevelLayer::COUNT] = {
+    "foreground", "background", "underground", "enemies", "above foreground", "collectibles"};
+
+// The music that plays in levels of the type, returns false if they don't have any
+static bool findLevelMusic(LevelType levelType, MusicID& music) {
+   switch (levelType) {
+      case LevelType::OVERWORLD:
+      case LevelType::START_UNDERGROUND:
+         music = MusicID::OVERWORLD;
+         return true;
+      case LevelType::UNDERGROUND:
+         music = MusicID::UNDERGROUND;
+         return true;
+      case LevelType::CASTLE:
+         music = MusicID::CASTLE;
+         return true;
+      case LevelType::UNDERWATER:
+         music = MusicID::UNDERWATER;
+         return true;
+      default:
+         return false;
+   }
 }
 
 GameScene::GameScene(int level, int subLevel) {
    this->level = level;
    this->subLevel = subLevel;
 
-   Map::loadBlockIDS();
-   Map::loadEnemyIDS();
-   Map::loadPlayerIDS();
    Map::loadIrregularBlockReferences();
 
    {
@@ -99,6 +120,14 @@ GameScene::GameScene(int level, int subLevel) {
    soundSystem = world->registerSystem<SoundSystem>();
    renderSystem = world->registerSystem<RenderSystem>();
 
+   // The sound effects are read while the first level loads, instead of when they are first
+   // played. The game over sound is left for the game over screen
+   for (int sound = 0; sound < (int)SoundID::COUNT; sound++) {
+      if ((SoundID)sound != SoundID::GAME_OVER) {
+         SoundManager::Get().preloadSound((SoundID)sound);
+      }
+   }
+
    setupLevel();
 }
 
@@ -109,7 +138,7 @@ void GameScene::update() {
 }
 
 void GameScene::emptyCommandQueue() {
-   for (auto command : commandQueue) {
+   for (auto& command : commandQueue) {
       command();
    }
    commandQueue.clear();
@@ -212,8 +241,7 @@ void GameScene::pause() {
    SoundManager::Get().pauseMusic();
    SoundManager::Get().pauseSounds();
 
-   Entity* pauseSound(world->create());
-   pauseSound->addComponent<SoundComponent>(SoundID::PAUSE);
+   AudioQueue::Get().playSound(SoundID::PAUSE);
 
    world->disableSystem<PhysicsSystem, PlayerSystem, AnimationSystem, EnemySystem,
                         CollectibleSystem, WarpSystem, FlagSystem, CallbackSystem, ScoreSystem>();
@@ -249,19 +277,48 @@ void GameScene::unpause() {
 void GameScene::setupLevel() {
    destroyWorldEntities();
 
-   enemiesMap.reset();
-   foregroundMap.reset();
-   undergroundMap.reset();
-   backgroundMap.reset();
-   aboveForegroundMap.reset();
-   collectiblesMap.reset();
+   mapSystem->setStreamingActive(false);
 
    WarpSystem::setClimbed(false);
    WarpSystem::setWarping(false);
 
-   gameLevel->clearLevelData();
+   // The constructor already loaded the first level, since the systems needed its data
+   if (!levelLoaded) {
+      enemiesMap.reset();
+      foregroundMap.reset();
+      undergroundMap.reset();
+      backgroundMap.reset();
+      aboveForegroundMap.reset();
+      collectiblesMap.reset();
 
-   loadLevel(level, subLevel);
+      gameLevel->clearLevelData();
+
+      loadLevel(level, subLevel);
+   }
+   levelLoaded = false;
+
+   bool levelCached = lastLoadCached;
+   double mapMilliseconds = lastLoadMilliseconds;
+
+   // The music starts once the transition screen ends, so it can be read while that is shown
+   MusicID levelMusic;
+   if (findLevelMusic(getLevelData().levelType, levelMusic)) {
+      SoundManager::Get().preloadMusic(levelMusic);
+   }
+
+   // Levels that had to be read now show which of their files took the longest, this includes
+   // the level that the game starts on
+   if (!levelCached && lastLoadedLevel) {
+      const PreparedLevel* preparedLevel = lastLoadedLevel.get();
+
+      std::cout << "Read World " << level << "-" << subLevel << ": properties "
+                << preparedLevel->propertiesMilliseconds << " ms";
+      for (int layer = 0; layer < (int)LevelLayer::COUNT; layer++) {
+         std::cout << ", " << LAYER_NAMES[layer] << " " << preparedLevel->layerMilliseconds[layer]
+                   << " ms";
+      }
+      std::cout << std::endl;
+   }
 
    TextureManager::Get().SetBackgroundColor(BackgroundColor::BLACK);
 
@@ -272,31 +329,51 @@ void GameScene::setupLevel() {
 
    renderSystem->setTransitionRendering(true);
 
-#ifdef __EMSCRIPTEN__
-   preloadEntities(mapSystem);
-#else
-   loaderThread = SDL_CreateThread(preloadEntities, "MapLoader", (void*)mapSystem);
-#endif
+   levelLoader.start(world, [=](World* loaderWorld) {
+      mapSystem->loadEntities(loaderWorld);
+   });
 
-   CommandScheduler::getInstance().addCommand(new DelayedCommand(
-       [=]() {
-#ifndef __EMSCRIPTEN__
-          SDL_WaitThread(loaderThread, NULL);
-#endif
-          world->enableSystem<CallbackSystem, PhysicsSystem, EnemySystem>();
-          renderSystem->setTransitionRendering(false);
+   // The transition screen ends as soon as the level has loaded and it was shown long enough.
+   // With fixed transitions it always ends on the same tick, and publish() waits for the loader
+   ScriptCommand* transition = new ScriptCommand(ScriptCommand::wait(MIN_TRANSITION_TIME));
 
-          TextureManager::Get().SetBackgroundColor(getLevelData().levelBackgroundColor);
+   if (!fixedTransitions) {
+      transition->addSteps(ScriptCommand::waitUntil([=]() -> bool {
+         return levelLoader.isFinished();
+      }));
+   }
+
+   transition->addSteps(ScriptCommand::run([=]() {
+      levelLoader.publish();
+
+      std::cout << "Loaded World " << level << "-" << subLevel << ": maps and properties in "
+                << mapMilliseconds << " ms" << (levelCached ? " (cached)" : "") << ", "
+                << levelLoader.getEntityCount()
+                << " entities in " << levelLoader.getLoadMilliseconds() << " ms" << std::endl;
+
+      Camera::Get().setCameraMaxX(getLevelData().cameraMax * SCALED_CUBE_SIZE);
+
+      world->enableSystem<CallbackSystem, PhysicsSystem, EnemySystem>();
+      renderSystem->setTransitionRendering(false);
+
+      TextureManager::Get().SetBackgroundColor(getLevelData().levelBackgroundColor);
+
+      scoreSystem->hideTransitionEntities();
+
+      startTimer();
+
+      startLevelMusic();
 
-          scoreSystem->hideTransitionEntities();
+      playerSystem->reset();
 
-          startTimer();
+      mapSystem->setStreamingActive(true);
+   }));
 
-          startLevelMusic();
+   CommandScheduler::getInstance().addCommand(transition);
+}
 
-          playerSystem->reset();
-       },
-       3.0));
+void GameScene::setFixedTransitions(bool fixed) {
+   fixedTransitions = fixed;
 }
 
 void GameScene::switchLevel(int level, int subLevel) {
@@ -333,32 +410,15 @@ void GameScene::startLevelMusic() {
 }
 
 void GameScene::setLevelMusic(LevelType levelType) {
-   switch (levelType) {
-      case LevelType::OVERWORLD:
-      case LevelType::START_UNDERGROUND: {
-         Entity* overworldMusic(world->create());
-         overworldMusic->addComponent<MusicComponent>(currentMusicID = MusicID::OVERWORLD);
-      } break;
-      case LevelType::UNDERGROUND: {
-         Entity* undergroundMusic(world->create());
-         undergroundMusic->addComponent<MusicComponent>(currentMusicID = MusicID::UNDERGROUND);
-      } break;
-      case LevelType::CASTLE: {
-         Entity* castleMusic(world->create());
-         castleMusic->addComponent<MusicComponent>(currentMusicID = MusicID::CASTLE);
-      } break;
-      case LevelType::UNDERWATER: {
-         Entity* underwaterMusic(world->create());
-         underwaterMusic->addComponent<MusicComponent>(currentMusicID = MusicID::UNDERWATER);
-      } break;
-      default:
-         break;
+   MusicID music;
+
+   if (findLevelMusic(levelType, music)) {
+      AudioQueue::Get().playMusic(currentMusicID = music);
    }
 }
 
 void GameScene::resumeLastPlayedMusic() {
-   Entity* music(world->create());
-   music->addComponent<MusicComponent>(currentMusicID);
+   AudioQueue::Get().playMusic(currentMusicID);
 }
 
 void GameScene::stopMusic() {
@@ -401,41 +461,29 @@ void GameScene::destroyWorldEntities() {
 }
 
 void GameScene::loadLevel(int level, int subLevel) {
-   // The path to the folder that the level files are in
-   std::string folderPath =
-       "res/data/World" + std::to_string(level) + "-" + std::to_string(subLevel) + "/";
-   // The path to the map data files (where the blocks are and stuff)
-   std::string mapDataPath =
-       folderPath + "World" + std::to_string(level) + "-" + std::to_string(subLevel);
-
-   std::string foregroundPath = mapDataPath + "_Foreground.csv";
-   std::string backgroundPath = mapDataPath + "_Background.csv";
-   std::string undergroundPath = mapDataPath + "_Underground.csv";
-   std::string enemiesPath = mapDataPath + "_Enemies.csv";
-   std::string aboveForegroundPath = mapDataPath + "_Above_Foreground.csv";
-   std::string collectiblesPath = mapDataPath + "_Collectibles.csv";
-
-   // Loads the special level properties
-   std::ifstream properties(mapDataPath + ".levelproperties");
-
-   std::string propertiesString;
-
-   if (properties.is_open()) {
-      std::ostringstream ss;
-      ss << properties.rdbuf();
-      propertiesString = ss.str();
-   }
+   auto startTime = std::chrono::steady_clock::now();
+
+   // The cached level stays untouched, so a restart can start from it again
+   std::shared_ptr<const PreparedLevel> preparedLevel =
+       levelPrefetcher.get(level, subLevel, &lastLoadCached);
+   lastLoadedLevel = preparedLevel;
+
+   gameLevel->getData() = preparedLevel->data;
 
-   properties.close();
+   foregroundMap = preparedLevel->foregroundMap;
+   backgroundMap = preparedLevel->backgroundMap;
+   undergroundMap = preparedLevel->undergroundMap;
+   enemiesMap = preparedLevel->enemiesMap;
+   aboveForegroundMap = preparedLevel->aboveForegroundMap;
+   collectiblesMap = preparedLevel->collectiblesMap;
 
-   gameLevel->loadLevelData(propertiesString);
+   lastLoadMilliseconds =
+       std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime)
+           .count();
+   levelLoaded = true;
 
-   foregroundMap.loadMap(foregroundPath.c_str());
-   backgroundMap.loadMap(backgroundPath.c_str());
-   undergroundMap.loadMap(undergroundPath.c_str());
-   enemiesMap.loadMap(enemiesPath.c_str());
-   aboveForegroundMap.loadMap(aboveForegroundPath.c_str());
-   collectiblesMap.loadMap(collectiblesPath.c_str());
+   // Gets the levels that this one leads to ready while it is being played
+   levelPrefetcher.prefetch(LevelPrefetcher::findNextLevels(level, subLevel, getLevelData()));
 }
 
 void GameScene::setUnderwater(bool val) {
@@ -13,8 +13,6 @@
 #include <memory>
 
 MenuScene::MenuScene() {
-   Map::loadBlockIDS();
-
    TextureManager::Get().SetBackgroundColor(BackgroundColor::BLUE);
 
    Camera::Get().setCameraX(0);
@@ -68,9 +66,11 @@ void MenuScene::createMenuEntities() {
 
    backgroundMap.loadMap("res/data/MenuBackground/MenuBackground_Background.csv");
 
-   for (unsigned int i = 0; i < backgroundMap.getLevelData().size(); i++) {
-      for (unsigned int j = 0; j < backgroundMap.getLevelData()[i].size(); j++) {
-         int entityID = backgroundMap.getLevelData()[i][j];
+   const TileGrid& backgroundData = backgroundMap.getLevelData();
+
+   for (int i = 0; i < backgroundData.getHeight(); i++) {
+      for (int j = 0; j < backgroundData.getWidth(); j++) {
+         int entityID = backgroundData[i][j];
          switch (entityID) {
             case -1:
                break;
@@ -49,6 +49,7 @@ void AnimationSystem::tick(World* world) {
                    animation->currentFrame = 0;
                 } else {
                    entity->remove<AnimationComponent>();
+                   EventBus::Get().publish(AnimationFinishedEvent{entity});
                    return;
                 }
              }
@@ -98,6 +99,7 @@ void AnimationSystem::tick(World* world) {
                   // coordinates
                   spritesheet->setSpritesheetCoordinates(frameCoordinates);
                   entity->remove<AnimationComponent>();
+                  EventBus::Get().publish(AnimationFinishedEvent{entity});
                   return;
                }
             }
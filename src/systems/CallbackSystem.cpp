@@ -2,18 +2,36 @@
 
 #include "ECS/Components.h"
 #include "ECS/ECS.h"
+#include "EventBus.h"
 
-void CallbackSystem::tick(World* world) {
-   world->find<CallbackComponent>([](Entity* entity) {
-      auto* callback = entity->getComponent<CallbackComponent>();
+namespace {
+
+// Only the component that the entity has right now runs. One that was replaced by adding another
+// component of the same type is left alone, like it was before the timers were in a wheel
+template <typename T>
+bool isCurrentComponent(T* component) {
+   return component->owner->template hasComponent<T>() &&
+          component->owner->template getComponent<T>() == component;
+}
 
-      callback->time--;
+}  // namespace
 
-      if (callback->time == 0) {
-         callback->callback(entity);
-         entity->remove<CallbackComponent>();
+void CallbackSystem::tick(World* world) {
+   CallbackComponent::timers.advance();
+
+   while (TimerWheel::Timer* expired = CallbackComponent::timers.popExpired()) {
+      auto* callback = static_cast<CallbackComponent*>(expired);
+      if (!isCurrentComponent(callback)) {
+         continue;
       }
-   });
+
+      Entity* entity = callback->owner;
+
+      callback->callback(entity);
+      entity->remove<CallbackComponent>();
+   }
+
+   EventBus::Get().dispatch();
 
    world->find<WaitUntilComponent>([](Entity* entity) {
       auto* waitUntil = entity->getComponent<WaitUntilComponent>();
@@ -23,23 +41,28 @@ void CallbackSystem::tick(World* world) {
       }
    });
 
-   world->find<TimerComponent>([](Entity* entity) {
-      auto* timer = entity->getComponent<TimerComponent>();
+   TimerComponent::timers.advance();
 
-      timer->time--;
-      if (timer->time == 0) {
-         timer->onExecute(entity);
-         timer->time = timer->delay;
+   while (TimerWheel::Timer* expired = TimerComponent::timers.popExpired()) {
+      auto* timer = static_cast<TimerComponent*>(expired);
+      if (!isCurrentComponent(timer)) {
+         continue;
       }
-   });
 
-   world->find<DestroyDelayedComponent>([world](Entity* entity) {
-      auto* destroy = entity->getComponent<DestroyDelayedComponent>();
+      timer->onExecute(timer->owner);
 
-      if (destroy->time > 0) {
-         destroy->time--;
-      } else if (destroy->time <= 0) {
-         world->destroy(entity);
+      // The timer could have been removed or reset by its own function
+      if (TimerComponent::timers.isExpiring(timer)) {
+         timer->reset();
       }
-   });
+   }
+
+   DestroyDelayedComponent::timers.advance();
+
+   while (TimerWheel::Timer* expired = DestroyDelayedComponent::timers.popExpired()) {
+      auto* destroy = static_cast<DestroyDelayedComponent*>(expired);
+      if (isCurrentComponent(destroy)) {
+         world->destroy(destroy->owner);
+      }
+   }
 }
@@ -1,6 +1,7 @@
 #include "systems/EnemySystem.h"
 
 #include "AABBCollision.h"
+#include "AudioQueue.h"
 #include "Camera.h"
 #include "Constants.h"
 #include "ECS/Components.h"
@@ -187,8 +188,10 @@ void EnemySystem::performLakituActions(World* world, Entity* entity) {
    {
       Entity* flag = world->findFirst<FlagComponent>();
 
-      if (flag->getComponent<PositionComponent>()->position.x - playerPosition->position.x <
-          30 * SCALED_CUBE_SIZE) {
+      // The flag isn't created yet when the level is streamed and it's still far away
+      if (flag != nullptr &&
+          flag->getComponent<PositionComponent>()->position.x - playerPosition->position.x <
+              30 * SCALED_CUBE_SIZE) {
          move->velocity.x = -4.0;
          return;
       }
@@ -226,8 +229,7 @@ void EnemySystem::checkEnemyDestroyed(World* world, Entity* enemy) {
          Entity* floatingText(world->create());
          floatingText->addComponent<CreateFloatingTextComponent>(enemy, std::to_string(100));
 
-         Entity* destroyedSound(world->create());
-         destroyedSound->addComponent<SoundComponent>(SoundID::KICK);
+         AudioQueue::Get().playSound(SoundID::KICK);
 
          enemy->addComponent<DestroyDelayedComponent>(1);
       }
@@ -248,8 +250,7 @@ void EnemySystem::checkEnemyDestroyed(World* world, Entity* enemy) {
       Entity* floatingText(world->create());
       floatingText->addComponent<CreateFloatingTextComponent>(enemy, std::to_string(100));
 
-      Entity* stompSound(world->create());
-      stompSound->addComponent<SoundComponent>(SoundID::STOMP);
+      AudioQueue::Get().playSound(SoundID::STOMP);
    }
 
    // Enemies that were destroyed through either a projectile or super star mario
@@ -268,8 +269,7 @@ void EnemySystem::checkEnemyDestroyed(World* world, Entity* enemy) {
       Entity* floatingText(world->create());
       floatingText->addComponent<CreateFloatingTextComponent>(enemy, std::to_string(100));
 
-      Entity* destroyedSound(world->create());
-      destroyedSound->addComponent<SoundComponent>(SoundID::KICK);
+      AudioQueue::Get().playSound(SoundID::KICK);
    }
 }
 
@@ -1,6 +1,7 @@
 #include "systems/FlagSystem.h"
 
 #include "AABBCollision.h"
+#include "AudioQueue.h"
 #include "Camera.h"
 #include "Constants.h"
 #include "ECS/Components.h"
@@ -45,28 +46,27 @@ void FlagSystem::climbFlag(World* world, Entity* player, Entity* flag) {
 
    scene->stopMusic();
 
-   Entity* flagSound(world->create());
-   flagSound->addComponent<SoundComponent>(SoundID::FLAG_RAISE);
+   AudioQueue::Get().playSound(SoundID::FLAG_RAISE);
 
    player->remove<GravityComponent>();
    player->addComponent<FrictionExemptComponent>();
 
    inSequence = true;
 
-   CommandScheduler::getInstance().addCommand(new SequenceCommand(std::vector<Command*>{
+   CommandScheduler::getInstance().addCommand(new ScriptCommand(
        /* Move to the other side of the flag */
-       new WaitUntilCommand([=]() -> bool {
+       ScriptCommand::waitUntil([=]() -> bool {
           return player->hasComponent<BottomCollisionComponent>() &&
                  flag->hasComponent<BottomCollisionComponent>();
        }),
-       new RunCommand([=]() {
+       ScriptCommand::run([=]() {
           playerMove->velocity.y = flagMove->velocity.y = 0;
           player->getComponent<TextureComponent>()->setHorizontalFlipped(true);
           playerPosition->position.x += 34;
        }),
-       new WaitCommand(0.6),
+       ScriptCommand::wait(0.6),
        /* Move towards the castle */
-       new RunCommand([=]() {
+       ScriptCommand::run([=]() {
           FlagSystem::setClimbing(false);
 
           Camera::Get().setCameraFrozen(false);
@@ -77,10 +77,12 @@ void FlagSystem::climbFlag(World* world, Entity* player, Entity* flag) {
           player->getComponent<TextureComponent>()->setHorizontalFlipped(false);
        }),
        /* Wait until the player hits a solid block */
-       new WaitUntilCommand([=]() -> bool {
-          return player->hasComponent<RightCollisionComponent>();
-       }),
-       new WaitUntilCommand([=]() -> bool {
+       ScriptCommand::waitFor<CollisionStartedEvent>(player,
+                                                     [](const CollisionStartedEvent& event) {
+                                                        return event.direction ==
+                                                               CollisionDirection::RIGHT;
+                                                     }),
+       ScriptCommand::waitUntil([=]() -> bool {
           static int nextLevelDelay = (int)std::round(MAX_FPS * 4.5);
 
           if (nextLevelDelay > 0) {
@@ -95,7 +97,7 @@ void FlagSystem::climbFlag(World* world, Entity* player, Entity* flag) {
           }
           return false;
        }),
-       new RunCommand([=]() mutable {
+       ScriptCommand::run([=]() mutable {
           Vector2i nextLevel = scene->getLevelData().nextLevel;
 
           player->getComponent<TextureComponent>()->setVisible(false);
@@ -107,7 +109,7 @@ void FlagSystem::climbFlag(World* world, Entity* player, Entity* flag) {
                  scene->switchLevel(nextLevel.x, nextLevel.y);
               },
               2.0));
-       })}));
+       })));
 }
 
 void FlagSystem::hitAxe(World* world, Entity* player, Entity* axe) {
@@ -151,8 +153,7 @@ void FlagSystem::hitAxe(World* world, Entity* player, Entity* axe) {
 
           bridgeComponent->connectedBridgeParts.pop_back();
 
-          Entity* bridgeCollapseSound(world->create());
-          bridgeCollapseSound->addComponent<SoundComponent>(SoundID::BLOCK_BREAK);
+          AudioQueue::Get().playSound(SoundID::BLOCK_BREAK);
 
           if (bridgeComponent->connectedBridgeParts.empty()) {
              entity->remove<TimerComponent>();
@@ -160,31 +161,28 @@ void FlagSystem::hitAxe(World* world, Entity* player, Entity* axe) {
        },
        5);
 
-   CommandScheduler::getInstance().addCommand(new SequenceCommand(std::vector<Command*>{
+   CommandScheduler::getInstance().addCommand(new ScriptCommand(
        /* Wait until the bridge is done collapsing, then make bowser fall */
-       new WaitUntilCommand([=]() -> bool {
+       ScriptCommand::waitUntil([=]() -> bool {
           return !bridge->hasComponent<TimerComponent>();
        }),
-       new RunCommand([=]() {
+       ScriptCommand::run([=]() {
           bowser->remove<FrozenComponent>();
           bowser->addComponent<DeadComponent>();
 
-          Entity* bowserFall(world->create());
-          bowserFall->addComponent<SoundComponent>(SoundID::BOWSER_FALL);
+          AudioQueue::Get().playSound(SoundID::BOWSER_FALL);
        }),
        /* Wait until bowser is not visible in the camera, then destroy the axe and move the player
         */
-       new WaitUntilCommand([bowser]() -> bool {
+       ScriptCommand::waitUntil([bowser]() -> bool {
           return !Camera::Get().inCameraRange(bowser->getComponent<PositionComponent>());
        }),
-       new RunCommand([=]() {
+       ScriptCommand::run([=]() {
           // Play the castle clear sound in 0.325 seconds, this is separate from the sequence to
           // avoid sequence interruption
           CommandScheduler::getInstance().addCommand(new DelayedCommand(
               [=]() {
-                 Entity* castleClear(world->create());
-
-                 castleClear->addComponent<SoundComponent>(SoundID::CASTLE_CLEAR);
+                 AudioQueue::Get().playSound(SoundID::CASTLE_CLEAR);
               },
               0.325));
 
@@ -197,10 +195,12 @@ void FlagSystem::hitAxe(World* world, Entity* player, Entity* axe) {
           player->remove<FrozenComponent>();
        }),
        /* Wait until mario runs into a block, then stop and switch to the next level */
-       new WaitUntilCommand([player]() -> bool {
-          return player->hasComponent<RightCollisionComponent>();
-       }),
-       new RunCommand([=]() mutable {
+       ScriptCommand::waitFor<CollisionStartedEvent>(player,
+                                                     [](const CollisionStartedEvent& event) {
+                                                        return event.direction ==
+                                                               CollisionDirection::RIGHT;
+                                                     }),
+       ScriptCommand::run([=]() mutable {
           inSequence = false;
 
           CommandScheduler::getInstance().addCommand(new DelayedCommand(
@@ -210,15 +210,13 @@ void FlagSystem::hitAxe(World* world, Entity* player, Entity* axe) {
                  if (nextLevel != Vector2i(0, 0)) {
                     player->getComponent<TextureComponent>()->setVisible(false);
                  } else {
-                    Entity* winMusic(world->create());
-                    winMusic->addComponent<MusicComponent>(MusicID::GAME_WON);
+                    AudioQueue::Get().playMusic(MusicID::GAME_WON);
                  }
 
                  scene->switchLevel(nextLevel.x, nextLevel.y);
               },
               5.0));
-       }),
-   }));
+       })));
 }
 
 void FlagSystem::tick(World* world) {
@@ -1,101 +1,24 @@
 #include "systems/MapSystem.h"
 
 #include "AABBCollision.h"
+#include "AudioQueue.h"
 #include "Camera.h"
 #include "Constants.h"
 #include "ECS/Components.h"
+#include "EventBus.h"
 #include "Map.h"
 #include "SoundManager.h"
 #include "command/CommandScheduler.h"
 #include "command/Commands.h"
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <iostream>
 #include <time.h>
 #include <tuple>
 #include <vector>
 
-template <typename T>
-std::tuple<Vector2i, T> getDataCoordinate(std::vector<std::tuple<Vector2i, T>> levelData,
-                                          Vector2i coordinate) {
-   for (auto tupledData : levelData) {
-      if (std::get<0>(tupledData) == coordinate) {
-         return tupledData;
-      }
-   }
-
-   return std::tuple<Vector2i, T>({0, 0}, T::NONE);
-}
-
-auto getPlatformCoordinate(
-    std::vector<std::tuple<Vector2i, PlatformMotionType, Direction, Vector2i, bool>> levelData,
-    Vector2i coordinate) {
-   for (auto tupledData : levelData) {
-      if (std::get<0>(tupledData) == coordinate) {
-         return std::tuple<PlatformMotionType, Direction, Vector2i, bool>(
-             std::get<1>(tupledData), std::get<2>(tupledData), std::get<3>(tupledData),
-             std::get<4>(tupledData));
-      }
-   }
-   return std::tuple<PlatformMotionType, Direction, Vector2i, bool>(
-       PlatformMotionType::NONE, Direction::NONE, Vector2i(0, 0), false);
-}
-
-auto getPlatformLevelCoordinate(std::vector<std::tuple<Vector2i, Vector2i, int>> levelData,
-                                Vector2i coordinate) {
-   for (auto tupledData : levelData) {
-      if (std::get<0>(tupledData) == coordinate) {
-         return std::tuple<Vector2i, Vector2i, int>(tupledData);
-      }
-   }
-   return std::tuple<Vector2i, Vector2i, int>(Vector2i(0, 0), Vector2i(0, 0), 0);
-}
-
-auto getPipeCoordinate(std::vector<std::tuple<Vector2i, Vector2i, Vector2i, Direction, Direction,
-                                              bool, BackgroundColor, LevelType, Vector2i>>
-                           levelData,
-                       Vector2i coordinate) {
-   for (auto tupledData : levelData) {
-      if (std::get<0>(tupledData) == coordinate) {
-         return std::tuple<Vector2i, Vector2i, Direction, Direction, bool, BackgroundColor,
-                           LevelType, Vector2i>(std::get<1>(tupledData), std::get<2>(tupledData),
-                                                std::get<3>(tupledData), std::get<4>(tupledData),
-                                                std::get<5>(tupledData), std::get<6>(tupledData),
-                                                std::get<7>(tupledData), std::get<8>(tupledData));
-      }
-   }
-
-   return std::tuple<Vector2i, Vector2i, Direction, Direction, bool, BackgroundColor, LevelType,
-                     Vector2i>({0, 0}, {0, 0}, Direction::NONE, Direction::NONE, false,
-                               BackgroundColor::BLACK, LevelType::NONE, Vector2i(0, 0));
-}
-
-auto getFireBarCoordinate(std::vector<std::tuple<Vector2i, int, RotationDirection, int>> levelData,
-                          Vector2i coordinate) {
-   for (auto tupledData : levelData) {
-      if (std::get<0>(tupledData) == coordinate) {
-         return tupledData;
-      }
-   }
-   return std::tuple<Vector2i, int, RotationDirection, int>(Vector2i(0, 0), 0.0,
-                                                            RotationDirection::NONE, 0);
-}
-
-auto getVineCoordinate(std::vector<std::tuple<Vector2i, Vector2i, Vector2i, int, Vector2i, int,
-                                              BackgroundColor, LevelType>>
-                           levelData,
-                       Vector2i coordinate) {
-   for (auto tupledData : levelData) {
-      if (std::get<0>(tupledData) == coordinate) {
-         return tupledData;
-      }
-   }
-
-   return std::tuple<Vector2i, Vector2i, Vector2i, int, Vector2i, int, BackgroundColor, LevelType>(
-       Vector2i(0), Vector2i(0), Vector2i(0), 0, Vector2i(0), 0, BackgroundColor::BLACK,
-       LevelType::NONE);
-}
-
 MapSystem::MapSystem(GameScene* scene) {
    this->scene = scene;
 }
@@ -106,36 +29,7 @@ float MapSystem::generateRandomNumber(float min, float max) {
 
 // Gets the Block ID that is equivalent to its ID in the Overworld
 int MapSystem::getReferenceBlockID(int entityID) {
-   if (entityID == -1) {
-      return -1;
-   }
-
-   if (Map::IrregularBlockReferences.find(entityID) != Map::IrregularBlockReferences.end()) {
-      return Map::IrregularBlockReferences.at(entityID);
-   }
-
-   Vector2i blockCoordinates = Map::BlockIDCoordinates.at(entityID);
-
-   int coordinateX = blockCoordinates.x;
-   int coordinateY = blockCoordinates.y;
-
-   if (coordinateY > 10 && blockCoordinates.x < 32) {
-      coordinateY -= 11;
-   }
-
-   if (coordinateX > 15 && coordinateX < 32) {
-      coordinateX -= 16;
-   } else if (coordinateX >= 32 && blockCoordinates.y < 10) {
-      coordinateX -= 32;
-   }
-
-   for (auto it = Map::BlockIDCoordinates.begin(); it != Map::BlockIDCoordinates.end(); it++) {
-      if (it->second == Vector2i(coordinateX, coordinateY)) {
-         return it->first;
-      }
-   }
-
-   return -1;
+   return Map::getReferenceBlockID(entityID);
 }
 
 int MapSystem::getReferenceBlockIDAsEntity(int entityID, int referenceID) {
@@ -162,35 +56,11 @@ int MapSystem::getReferenceBlockIDAsEntity(int entityID, int referenceID) {
       referenceCoordinateX -= 32;
    }
 
-   for (auto it = Map::BlockIDCoordinates.begin(); it != Map::BlockIDCoordinates.end(); it++) {
-      if (it->second == Vector2i(referenceCoordinateX, referenceCoordinateY)) {
-         return it->first;
-      }
-   }
-
-   return -1;
+   return Map::BlockIDCoordinates.getID(referenceCoordinateX, referenceCoordinateY);
 }
 
 int MapSystem::getReferenceEnemyID(int entityID) {
-   if (entityID == -1) {
-      return -1;
-   }
-   Vector2i entityCoordinates = Map::EnemyIDCoordinates.at(entityID);
-
-   int coordinateX = entityCoordinates.x;
-   int coordinateY = entityCoordinates.y;
-
-   if (coordinateY > 2 && coordinateY < 12) {
-      coordinateY -= (coordinateY - (coordinateY % 3));
-   }
-
-   for (auto it = Map::EnemyIDCoordinates.begin(); it != Map::EnemyIDCoordinates.end(); it++) {
-      if (it->second == Vector2i(coordinateX, coordinateY)) {
-         return it->first;
-      }
-   }
-
-   return -1;
+   return Map::getReferenceEnemyID(entityID);
 }
 
 int MapSystem::getReferenceEnemyIDAsEntity(int entityID, int referenceID) {
@@ -210,13 +80,7 @@ int MapSystem::getReferenceEnemyIDAsEntity(int entityID, int referenceID) {
       referenceCoordinateY += (entityCoordinateY - (entityCoordinateY % 3));
    }
 
-   for (auto it = Map::EnemyIDCoordinates.begin(); it != Map::EnemyIDCoordinates.end(); it++) {
-      if (it->second == Vector2i(referenceCoordinateX, referenceCoordinateY)) {
-         return it->first;
-      }
-   }
-
-   return -1;
+   return Map::EnemyIDCoordinates.getID(referenceCoordinateX, referenceCoordinateY);
 }
 
 Entity* MapSystem::createBlockEntity(World* world, int coordinateX, int coordinateY, int entityID) {
@@ -256,10 +120,28 @@ Entity* MapSystem::createBackgroundEntity(World* world, int coordinateX, int coo
    return entity;
 }
 
+Entity* MapSystem::createAboveForegroundEntity(World* world, int coordinateX, int coordinateY,
+                                               int entityID) {
+   Entity* entity(world->create());
+
+   entity->addComponent<PositionComponent>(Vector2f(coordinateX, coordinateY) * SCALED_CUBE_SIZE,
+                                           Vector2i(SCALED_CUBE_SIZE));
+
+   entity->addComponent<TextureComponent>(scene->blockTexture, false, false);
+
+   entity->addComponent<SpritesheetComponent>(ORIGINAL_CUBE_SIZE, ORIGINAL_CUBE_SIZE, 1, 1, 1,
+                                              ORIGINAL_CUBE_SIZE, ORIGINAL_CUBE_SIZE,
+                                              Map::BlockIDCoordinates.at(entityID));
+
+   entity->addComponent<AboveForegroundComponent>();
+
+   return entity;
+}
+
 // Creates a moving platform entity
 Entity* MapSystem::createPlatformEntity(
     World* world, int coordinateX, int coordinateY, int entityID, int platformLength,
-    std::tuple<PlatformMotionType, Direction, Vector2i, bool> platformData) {
+    const MovingPlatformData& platformData) {
    Entity* platform(world->create());
 
    platform->addComponent<PositionComponent>(Vector2f(coordinateX, coordinateY) * SCALED_CUBE_SIZE,
@@ -275,7 +157,7 @@ Entity* MapSystem::createPlatformEntity(
 
    platform->addComponent<TileComponent>();
 
-   if (std::get<3>(platformData)) {
+   if (std::get<4>(platformData)) {
       platform->getComponent<PositionComponent>()->position.x += SCALED_CUBE_SIZE / 2;
    }
 
@@ -285,10 +167,10 @@ Entity* MapSystem::createPlatformEntity(
 
    auto* move = platform->addComponent<MovingComponent>(Vector2f(0, 0), Vector2f(0, 0));
 
-   switch (std::get<0>(platformData)) {
+   switch (std::get<1>(platformData)) {
       case PlatformMotionType::ONE_DIRECTION_REPEATED: {
-         Direction movingDirection = std::get<1>(platformData);
-         Vector2i minMax = std::get<2>(platformData);
+         Direction movingDirection = std::get<2>(platformData);
+         Vector2i minMax = std::get<3>(platformData);
 
          minMax += Vector2i(0, 1);
 
@@ -315,7 +197,7 @@ Entity* MapSystem::createPlatformEntity(
          }
       } break;
       case PlatformMotionType::ONE_DIRECTION_CONTINUOUS: {
-         Direction movingDirection = std::get<1>(platformData);
+         Direction movingDirection = std::get<2>(platformData);
 
          platform->addComponent<MovingPlatformComponent>(
              PlatformMotionType::ONE_DIRECTION_CONTINUOUS, movingDirection, Vector2i(0, 0));
@@ -338,8 +220,8 @@ Entity* MapSystem::createPlatformEntity(
          }
       } break;
       case PlatformMotionType::BACK_AND_FORTH: {
-         Direction movingDirection = std::get<1>(platformData);
-         Vector2i minMax = std::get<2>(platformData);
+         Direction movingDirection = std::get<2>(platformData);
+         Vector2i minMax = std::get<3>(platformData);
 
          minMax += Vector2i(0, 1);
 
@@ -359,8 +241,8 @@ Entity* MapSystem::createPlatformEntity(
    return platform;
 }
 
-Entity* MapSystem::createPlatformLevelEntity(
-    World* world, std::tuple<Vector2i, Vector2i, int> platformLevelData) {
+Entity* MapSystem::createPlatformLevelEntity(World* world,
+                                             const PlatformLevelData& platformLevelData) {
    Vector2i leftCoordinate = std::get<0>(platformLevelData);
    Vector2i rightCoordinate = std::get<1>(platformLevelData);
    int pulleyHeight = std::get<2>(platformLevelData) + 1;
@@ -370,7 +252,7 @@ Entity* MapSystem::createPlatformLevelEntity(
    int rightLineX = rightCoordinate.x + 1;
 
    int pulleyID = getReferenceBlockIDAsEntity(
-       scene->backgroundMap.getLevelData()[pulleyHeight - 1][leftLineX], 391);
+       scene->backgroundMap.getLevelData().at(leftLineX, pulleyHeight - 1), 391);
 
    if (pulleyID == -1) {
       pulleyID = 391;
@@ -434,8 +316,7 @@ void MapSystem::addItemDispenser(World* world, Entity* entity, int entityID, int
    switch (mysteryBox->boxType) {
       case MysteryBoxType::MUSHROOM:
          mysteryBox->whenDispensed = [=](Entity* originalBlock) {
-            Entity* dispenseSound(world->create());
-            dispenseSound->addComponent<SoundComponent>(SoundID::POWER_UP_APPEAR);
+            AudioQueue::Get().playSound(SoundID::POWER_UP_APPEAR);
 
             if (world->findFirst<PlayerComponent>()->getComponent<PlayerComponent>()->playerState !=
                 PlayerState::SMALL_MARIO) {
@@ -511,8 +392,7 @@ void MapSystem::addItemDispenser(World* world, Entity* entity, int entityID, int
          break;
       case MysteryBoxType::COINS:
          mysteryBox->whenDispensed = [=](Entity* originalBlock) {
-            Entity* coinSound(world->create());
-            coinSound->addComponent<SoundComponent>(SoundID::COIN);
+            AudioQueue::Get().playSound(SoundID::COIN);
 
             Entity* addScore(world->create());
             addScore->addComponent<AddScoreComponent>(100, true);
@@ -556,8 +436,7 @@ void MapSystem::addItemDispenser(World* world, Entity* entity, int entityID, int
          break;
       case MysteryBoxType::SUPER_STAR: {
          mysteryBox->whenDispensed = [=](Entity* originalBlock) {
-            Entity* dispenseSound(world->create());
-            dispenseSound->addComponent<SoundComponent>(SoundID::POWER_UP_APPEAR);
+            AudioQueue::Get().playSound(SoundID::POWER_UP_APPEAR);
 
             Entity* star(world->create());
 
@@ -598,8 +477,7 @@ void MapSystem::addItemDispenser(World* world, Entity* entity, int entityID, int
       } break;
       case MysteryBoxType::ONE_UP: {
          mysteryBox->whenDispensed = [=](Entity* originalBlock) {
-            Entity* dispenseSound(world->create());
-            dispenseSound->addComponent<SoundComponent>(SoundID::POWER_UP_APPEAR);
+            AudioQueue::Get().playSound(SoundID::POWER_UP_APPEAR);
 
             Entity* oneup(world->create());
 
@@ -638,13 +516,14 @@ void MapSystem::addItemDispenser(World* world, Entity* entity, int entityID, int
          Vector2f blockPosition =
              entity->getComponent<PositionComponent>()->position / SCALED_CUBE_SIZE;
 
-         auto vineData =
-             getVineCoordinate(scene->getLevelData().vineLocations, blockPosition.convertTo<int>());
+         const VineData* vine = scene->getLevelData().findVine(blockPosition.convertTo<int>());
 
-         if (std::get<0>(vineData) == Vector2i(0, 0)) {
+         if (vine == nullptr) {
             break;
          }
 
+         VineData vineData = *vine;
+
          std::vector<Entity*> vineParts;
 
          int vineLength = 0;
@@ -653,8 +532,7 @@ void MapSystem::addItemDispenser(World* world, Entity* entity, int entityID, int
          int vineBodyID = getReferenceBlockIDAsEntity(entityID, 148);
 
          mysteryBox->whenDispensed = [=](Entity* originalBlock) mutable {
-            Entity* dispenseSound(world->create());
-            dispenseSound->addComponent<SoundComponent>(SoundID::POWER_UP_APPEAR);
+            AudioQueue::Get().playSound(SoundID::POWER_UP_APPEAR);
 
             originalBlock->addComponent<AboveForegroundComponent>();
 
@@ -703,7 +581,7 @@ void MapSystem::addItemDispenser(World* world, Entity* entity, int entityID, int
                    return vineParts.back()->getComponent<PositionComponent>()->getBottom() <=
                           position->getTop();
                 },
-                [=, &blockTexture, &vineParts, &vineLength](Entity* entity) {
+                [=, &blockTexture, &vineParts, &vineLength, &vineData](Entity* entity) {
                    auto* position = originalBlock->getComponent<PositionComponent>();
 
                    // Adds another part to the vine
@@ -766,10 +644,14 @@ void MapSystem::createForegroundEntities(World* world, int coordinateX, int coor
             entity->addComponent<InvisibleBlockComponent>();
             entity->addComponent<BumpableComponent>();
 
-            MysteryBoxType collectibleType = MysteryBoxType::NONE;
+            // Invisible blocks can't grow vines
+            MysteryBoxType collectibleType =
+                scene->getLevelData().getMysteryBoxType(Vector2i(coordinateX, coordinateY));
+            if (collectibleType == MysteryBoxType::VINES) {
+               collectibleType = MysteryBoxType::NONE;
+            }
 
             int collectibleID = scene->collectiblesMap.getLevelData()[coordinateY][coordinateX];
-            int referenceCollectibleID = getReferenceBlockID(collectibleID);
 
             int blankBlockID;
 
@@ -790,23 +672,6 @@ void MapSystem::createForegroundEntities(World* world, int coordinateX, int coor
                }
             }
 
-            switch (referenceCollectibleID) {
-               case 52:  // One-up
-                  collectibleType = MysteryBoxType::ONE_UP;
-                  break;
-               case 96:  // Super Star
-                  collectibleType = MysteryBoxType::SUPER_STAR;
-                  break;
-               case 144:  // Coin
-                  collectibleType = MysteryBoxType::COINS;
-                  break;
-               case 608:  // Mushroom
-                  collectibleType = MysteryBoxType::MUSHROOM;
-                  break;
-               default:
-                  break;
-            }
-
             if (collectibleType != MysteryBoxType::NONE) {
                entity->addComponent<MysteryBoxComponent>(collectibleType);
 
@@ -899,8 +764,7 @@ void MapSystem::createForegroundEntities(World* world, int coordinateX, int coor
 
                 bulletBill->addComponent<ParticleComponent>();
 
-                Entity* cannonSound(world->create());
-                cannonSound->addComponent<SoundComponent>(SoundID::CANNON_FIRE);
+                AudioQueue::Get().playSound(SoundID::CANNON_FIRE);
 
                 bulletBill->addComponent<CrushableComponent>([](Entity* entity) {
                    entity->getComponent<MovingComponent>()->velocity.x = 0;
@@ -967,27 +831,11 @@ void MapSystem::createForegroundEntities(World* world, int coordinateX, int coor
 
          entity->addComponent<BumpableComponent>();
 
-         MysteryBoxType collectibleType = MysteryBoxType::COINS;
-
-         int collectibleID = scene->collectiblesMap.getLevelData()[coordinateY][coordinateX];
-         if (collectibleID != -1) {
-            int referenceCollectibleID = getReferenceBlockID(collectibleID);
-            switch (referenceCollectibleID) {
-               case 52:  // One-up
-                  collectibleType = MysteryBoxType::ONE_UP;
-                  break;
-               case 96:  // Super Star
-                  collectibleType = MysteryBoxType::SUPER_STAR;
-                  break;
-               case 144:  // Coin
-                  collectibleType = MysteryBoxType::COINS;
-                  break;
-               case 608:  // Mushroom
-                  collectibleType = MysteryBoxType::MUSHROOM;
-                  break;
-               default:
-                  break;
-            }
+         // Question blocks give out a coin unless something else is placed in them
+         MysteryBoxType collectibleType =
+             scene->getLevelData().getMysteryBoxType(Vector2i(coordinateX, coordinateY));
+         if (collectibleType == MysteryBoxType::NONE || collectibleType == MysteryBoxType::VINES) {
+            collectibleType = MysteryBoxType::COINS;
          }
 
          if (collectibleType != MysteryBoxType::NONE) {
@@ -1030,29 +878,8 @@ void MapSystem::createForegroundEntities(World* world, int coordinateX, int coor
 
          entity->addComponent<BumpableComponent>();
 
-         MysteryBoxType boxType = MysteryBoxType::NONE;
-
-         int collectibleID = scene->collectiblesMap.getLevelData()[coordinateY][coordinateX];
-         if (collectibleID != -1) {
-            int referenceCollectibleID = getReferenceBlockID(collectibleID);
-            switch (referenceCollectibleID) {
-               case 52:  // One-up
-                  boxType = MysteryBoxType::ONE_UP;
-                  break;
-               case 96:  // Super Star
-                  boxType = MysteryBoxType::SUPER_STAR;
-                  break;
-               case 144:  // Coin
-                  boxType = MysteryBoxType::COINS;
-                  break;
-               case 148:  // VINES
-                  boxType = MysteryBoxType::VINES;
-                  break;
-               case 608:  // Mushroom
-                  boxType = MysteryBoxType::MUSHROOM;
-                  break;
-            }
-         }
+         MysteryBoxType boxType =
+             scene->getLevelData().getMysteryBoxType(Vector2i(coordinateX, coordinateY));
 
          if (boxType != MysteryBoxType::NONE) {
             entity->addComponent<MysteryBoxComponent>(boxType);
@@ -1086,19 +913,18 @@ void MapSystem::createForegroundEntities(World* world, int coordinateX, int coor
       case 392: {  // BRIDGE
          if (scene->getLevelData().levelType == LevelType::CASTLE) {
             if (getReferenceBlockID(
-                    scene->foregroundMap.getLevelData()[coordinateY][coordinateX - 1]) != 392) {
+                    scene->foregroundMap.getLevelData().at(coordinateX - 1, coordinateY)) != 392) {
                Entity* bridge(createBlockEntity(world, coordinateX, coordinateY, entityID));
 
                auto* bridgeComponent = bridge->addComponent<BridgeComponent>();
 
                bridgeComponent->connectedBridgeParts.push_back(bridge);
 
+               const TileGrid& foreground = scene->foregroundMap.getLevelData();
                int futureCoordinateCheck = coordinateX;
 
-               while (
-                   getReferenceBlockID(
-                       scene->foregroundMap.getLevelData()[coordinateY][++futureCoordinateCheck]) ==
-                   392) {
+               while (getReferenceBlockID(foreground.at(++futureCoordinateCheck, coordinateY)) ==
+                      392) {
                   Entity* connectedBridge(
                       createBlockEntity(world, futureCoordinateCheck, coordinateY, entityID));
 
@@ -1115,25 +941,26 @@ void MapSystem::createForegroundEntities(World* world, int coordinateX, int coor
       } break;
       /* ****************************************************************** */
       case 761: {  // MOVING PLATFORM (2 wide)
-         auto platformData = getPlatformCoordinate(scene->getLevelData().movingPlatformDirections,
-                                                   Vector2i(coordinateX, coordinateY));
+         const MovingPlatformData* platformData =
+             scene->getLevelData().findMovingPlatform(Vector2i(coordinateX, coordinateY));
 
-         createPlatformEntity(world, coordinateX, coordinateY, entityID, 2, platformData);
+         createPlatformEntity(world, coordinateX, coordinateY, entityID, 2,
+                              (platformData != nullptr) ? *platformData : MovingPlatformData());
       } break;
       /* ****************************************************************** */
       case 809: {  // MOVING PLATFORM (3 wide)
-         auto platformData = getPlatformCoordinate(scene->getLevelData().movingPlatformDirections,
-                                                   Vector2i(coordinateX, coordinateY));
-         if (std::get<0>(platformData) != PlatformMotionType::NONE) {
-            createPlatformEntity(world, coordinateX, coordinateY, entityID, 3, platformData);
+         const MovingPlatformData* platformData =
+             scene->getLevelData().findMovingPlatform(Vector2i(coordinateX, coordinateY));
+         if (platformData != nullptr && std::get<1>(*platformData) != PlatformMotionType::NONE) {
+            createPlatformEntity(world, coordinateX, coordinateY, entityID, 3, *platformData);
             return;
          }
 
-         auto platformLevelData = getPlatformLevelCoordinate(
-             scene->getLevelData().platformLevelLocations, Vector2i(coordinateX, coordinateY));
+         const PlatformLevelData* platformLevelData =
+             scene->getLevelData().findPlatformLevel(Vector2i(coordinateX, coordinateY));
 
-         if (std::get<0>(platformLevelData) != Vector2i(0, 0)) {
-            createPlatformLevelEntity(world, platformLevelData);
+         if (platformLevelData != nullptr) {
+            createPlatformLevelEntity(world, *platformLevelData);
             return;
          }
 
@@ -1158,13 +985,14 @@ void MapSystem::createForegroundEntities(World* world, int coordinateX, int coor
 
          entity->addComponent<FrictionExemptComponent>();
 
-         entity->addComponent<WaitUntilComponent>(
-             [](Entity* entity) -> bool {
-                return entity->hasComponent<TopCollisionComponent>();
-             },
-             [](Entity* entity) {
-                entity->getComponent<MovingComponent>()->velocity.x = 2.0;
-                entity->remove<WaitUntilComponent>();
+         // Starts moving once the player lands on it
+         EventBus::Get().subscribe<CollisionStartedEvent>(
+             entity, [](const CollisionStartedEvent& event) {
+                if (event.direction != CollisionDirection::TOP) {
+                   return false;
+                }
+                event.entity->getComponent<MovingComponent>()->velocity.x = 2.0;
+                return true;
              });
 
          entity->addComponent<ForegroundComponent>();
@@ -1299,19 +1127,21 @@ void MapSystem::createEnemyEntities(World* world, int coordinateX, int coordinat
 
          koopa->addComponent<FrictionExemptComponent>();
 
-         koopa->addComponent<WaitUntilComponent>(
-             [](Entity* entity) {
-                return entity->hasComponent<BottomCollisionComponent>();
-             },
-             [](Entity* entity) {
-                entity->remove<BottomCollisionComponent>();
+         // Jumps again every time it lands, until it is crushed
+         EventBus::SubscriptionID jumpSubscription =
+             EventBus::Get().subscribe<CollisionStartedEvent>(
+                 koopa, [](const CollisionStartedEvent& event) {
+                    if (event.direction == CollisionDirection::BOTTOM) {
+                       event.entity->remove<BottomCollisionComponent>();
 
-                entity->getComponent<MovingComponent>()->velocity.y = -8;
-                entity->getComponent<MovingComponent>()->acceleration.y = -0.22;
-             });
+                       event.entity->getComponent<MovingComponent>()->velocity.y = -8;
+                       event.entity->getComponent<MovingComponent>()->acceleration.y = -0.22;
+                    }
+                    return false;
+                 });
 
          koopa->addComponent<CrushableComponent>([=](Entity* entity) {
-            entity->remove<WaitUntilComponent>();
+            EventBus::Get().unsubscribe(jumpSubscription);
 
             entity->getComponent<EnemyComponent>()->enemyType = EnemyType::KOOPA;
 
@@ -1506,7 +1336,7 @@ void MapSystem::createEnemyEntities(World* world, int coordinateX, int coordinat
 
          int inCloudID = getReferenceEnemyIDAsEntity(entityID, 86);
 
-         std::function<Entity*(Entity*)> createSpine = [=](Entity* entity) {
+         auto createSpine = [=](Entity* entity) {
             auto* position = entity->getComponent<PositionComponent>();
             auto* texture = entity->getComponent<TextureComponent>();
 
@@ -1544,9 +1374,9 @@ void MapSystem::createEnemyEntities(World* world, int coordinateX, int coordinat
                return;
             }
 
-            CommandScheduler::getInstance().addCommand(new SequenceCommand(std::vector<Command*>{
+            CommandScheduler::getInstance().addCommand(new ScriptCommand(
                 /* Set Lakitu to be in the cloud */
-                new RunCommand([=]() {
+                ScriptCommand::run([=]() {
                    if (!scene->getWorld()->hasEntity(entity)) {
                       return;
                    }
@@ -1556,9 +1386,9 @@ void MapSystem::createEnemyEntities(World* world, int coordinateX, int coordinat
                    spritesheet->setEntityHeight(ORIGINAL_CUBE_SIZE);
                    spritesheet->setSpritesheetCoordinates(Map::EnemyIDCoordinates.at(inCloudID));
                 }),
-                new WaitCommand(0.75),
+                ScriptCommand::wait(0.75),
                 /* Move out of the cloud and launch a spine */
-                new RunCommand([=]() {
+                ScriptCommand::run([=]() {
                    if (!scene->getWorld()->hasEntity(entity)) {
                       return;
                    }
@@ -1569,8 +1399,7 @@ void MapSystem::createEnemyEntities(World* world, int coordinateX, int coordinat
                    spritesheet->setSpritesheetCoordinates(Map::EnemyIDCoordinates.at(entityID));
 
                    createSpine(entity);
-                }),
-            }));
+                })));
          };
 
          lakitu->addComponent<TimerComponent>(throwSpine, 3 * MAX_FPS);
@@ -1628,8 +1457,9 @@ void MapSystem::createEnemyEntities(World* world, int coordinateX, int coordinat
 
             entity->getComponent<HammerBroComponent>()->hammer = hammer;
 
+            // The animation is the copy that throwHammer holds, so the callback stays small
             entity->addComponent<CallbackComponent>(
-                [=](Entity* entity) {
+                [=, &armsDownAnimation](Entity* entity) {
                    // Fail safe in case if crushed before hammer is thrown
                    if (!entity->hasComponent<HammerBroComponent>()) {
                       world->destroy(hammer);
@@ -1740,8 +1570,7 @@ void MapSystem::createEnemyEntities(World* world, int coordinateX, int coordinat
                     [=](Entity* entity, int number = 0) {
                        animation->frameIDS = mouthOpenAnimation;
 
-                       Entity* blastSound(world->create());
-                       blastSound->addComponent<SoundComponent>(SoundID::BOWSER_FIRE);
+                       AudioQueue::Get().playSound(SoundID::BOWSER_FIRE);
 
                        Entity* fireBlast(world->create());
 
@@ -2005,8 +1834,7 @@ void MapSystem::createEnemyEntities(World* world, int coordinateX, int coordinat
                 return Camera::Get().inCameraRange(entity->getComponent<PositionComponent>());
              },
              [=](Entity* entity) {
-                Entity* cannonSound(world->create());
-                cannonSound->addComponent<SoundComponent>(SoundID::CANNON_FIRE);
+                AudioQueue::Get().playSound(SoundID::CANNON_FIRE);
 
                 entity->remove<WaitUntilComponent>();
              });
@@ -2068,7 +1896,7 @@ void MapSystem::createEnemyEntities(World* world, int coordinateX, int coordinat
       } break;
       /* ****************************************************************** */
       case 498: {  // CHEEP CHEEP (RED)
-         if (scene->backgroundMap.getLevelData()[coordinateY][coordinateX] ==
+         if (scene->backgroundMap.getLevelData().at(coordinateX, coordinateY) ==
              186) {  // If underwater
             Entity* entity(world->create());
 
@@ -2194,66 +2022,265 @@ void MapSystem::createEnemyEntities(World* world, int coordinateX, int coordinat
 }
 
 void MapSystem::createFireBarEntities(World* world) {
-   for (auto fireBarCoordinate : scene->getLevelData().fireBarLocations) {
-      Vector2i barCoordinate = std::get<0>(fireBarCoordinate);
-      float startAngle = (float)std::get<1>(fireBarCoordinate);
-      RotationDirection rotationDirection = std::get<2>(fireBarCoordinate);
-      int barLength = std::get<3>(fireBarCoordinate);
-
-      for (int bar = 0; bar < barLength; bar++) {
-         Entity* barElement(world->create());
-
-         barElement->addComponent<PositionComponent>(
-             Vector2f(barCoordinate.x, barCoordinate.y) * SCALED_CUBE_SIZE,
-             Vector2i(SCALED_CUBE_SIZE),
-             SDL_Rect{0, 0, SCALED_CUBE_SIZE / 4, SCALED_CUBE_SIZE / 4});
-
-         barElement->addComponent<TextureComponent>(scene->blockTexture, false, false);
-
-         barElement->addComponent<SpritesheetComponent>(
-             ORIGINAL_CUBE_SIZE, ORIGINAL_CUBE_SIZE, 1, 1, 1, ORIGINAL_CUBE_SIZE,
-             ORIGINAL_CUBE_SIZE, Map::BlockIDCoordinates.at(611));
-
-         barElement->addComponent<AnimationComponent>(std::vector<int>{611, 612, 613, 614}, 12,
-                                                      Map::BlockIDCoordinates);
-
-         barElement->addComponent<FireBarComponent>(
-             Vector2f(barCoordinate.x, barCoordinate.y) * SCALED_CUBE_SIZE,
-             bar * ORIGINAL_CUBE_SIZE, startAngle, rotationDirection);
-
-         barElement->addComponent<TimerComponent>(
-             [&](Entity* entity) {
-                auto* barComponent = entity->getComponent<FireBarComponent>();
-
-                switch (barComponent->direction) {
-                   case RotationDirection::CLOCKWISE:
-                      barComponent->barAngle -= 10;
-                      break;
-                   case RotationDirection::COUNTER_CLOCKWISE:
-                      barComponent->barAngle += 10;
-                      break;
-                   default:
-                      break;
-                }
-             },
-             6);
+   for (const FireBarData& fireBarData : scene->getLevelData().fireBarLocations) {
+      createFireBarEntity(world, fireBarData);
+   }
+}
+
+void MapSystem::createFireBarEntity(World* world, const FireBarData& fireBarData) {
+   Vector2i barCoordinate = std::get<0>(fireBarData);
+   float startAngle = (float)std::get<1>(fireBarData);
+   RotationDirection rotationDirection = std::get<2>(fireBarData);
+   int barLength = std::get<3>(fireBarData);
+
+   for (int bar = 0; bar < barLength; bar++) {
+      Entity* barElement(world->create());
+
+      barElement->addComponent<PositionComponent>(
+          Vector2f(barCoordinate.x, barCoordinate.y) * SCALED_CUBE_SIZE,
+          Vector2i(SCALED_CUBE_SIZE),
+          SDL_Rect{0, 0, SCALED_CUBE_SIZE / 4, SCALED_CUBE_SIZE / 4});
+
+      barElement->addComponent<TextureComponent>(scene->blockTexture, false, false);
 
-         if (bar != barLength - 1) {
-            barElement->addComponent<EnemyComponent>(EnemyType::FIRE_BAR);
+      barElement->addComponent<SpritesheetComponent>(
+          ORIGINAL_CUBE_SIZE, ORIGINAL_CUBE_SIZE, 1, 1, 1, ORIGINAL_CUBE_SIZE, ORIGINAL_CUBE_SIZE,
+          Map::BlockIDCoordinates.at(611));
+
+      barElement->addComponent<AnimationComponent>(std::vector<int>{611, 612, 613, 614}, 12,
+                                                   Map::BlockIDCoordinates);
+
+      barElement->addComponent<FireBarComponent>(
+          Vector2f(barCoordinate.x, barCoordinate.y) * SCALED_CUBE_SIZE,
+          bar * ORIGINAL_CUBE_SIZE, startAngle, rotationDirection);
+
+      barElement->addComponent<TimerComponent>(
+          [&](Entity* entity) {
+             auto* barComponent = entity->getComponent<FireBarComponent>();
+
+             switch (barComponent->direction) {
+                case RotationDirection::CLOCKWISE:
+                   barComponent->barAngle -= 10;
+                   break;
+                case RotationDirection::COUNTER_CLOCKWISE:
+                   barComponent->barAngle += 10;
+                   break;
+                default:
+                   break;
+             }
+          },
+          6);
+
+      if (bar != barLength - 1) {
+         barElement->addComponent<EnemyComponent>(EnemyType::FIRE_BAR);
+      }
+
+      barElement->addComponent<ForegroundComponent>();
+   }
+}
+
+void MapSystem::indexMysteryBoxes() {
+   const TileGrid& collectiblesData = scene->collectiblesMap.getLevelData();
+   CoordinateIndex<MysteryBoxType>& mysteryBoxTypes = scene->getLevelData().mysteryBoxTypes;
+
+   mysteryBoxTypes.clear();
+
+   for (int i = 0; i < collectiblesData.getHeight(); i++) {
+      for (int j = 0; j < collectiblesData.getWidth(); j++) {
+         int collectibleID = collectiblesData[i][j];
+         if (collectibleID == -1) {
+            continue;
+         }
+
+         MysteryBoxType boxType = MysteryBoxType::NONE;
+
+         switch (getReferenceBlockID(collectibleID)) {
+            case 52:  // One-up
+               boxType = MysteryBoxType::ONE_UP;
+               break;
+            case 96:  // Super Star
+               boxType = MysteryBoxType::SUPER_STAR;
+               break;
+            case 144:  // Coin
+               boxType = MysteryBoxType::COINS;
+               break;
+            case 148:  // VINES
+               boxType = MysteryBoxType::VINES;
+               break;
+            case 608:  // Mushroom
+               boxType = MysteryBoxType::MUSHROOM;
+               break;
+            default:
+               break;
          }
 
-         barElement->addComponent<ForegroundComponent>();
+         if (boxType != MysteryBoxType::NONE) {
+            mysteryBoxTypes.emplace(Vector2i(j, i), boxType);
+         }
       }
    }
 }
 
+bool MapSystem::streamingEnabled = false;
+
+void MapSystem::setStreamingEnabled(bool enabled) {
+   streamingEnabled = enabled;
+}
+
+void MapSystem::createAboveForegroundEntities(World* world, int coordinateX, int coordinateY,
+                                              int entityID, int referenceID) {
+   switch (referenceID) {
+      case -1:
+         break;
+      case 150:
+      case 292: {  // WARP PIPE
+         Entity* entity(world->create());
+
+         auto* position = entity->addComponent<PositionComponent>(
+             Vector2f(coordinateX, coordinateY) * SCALED_CUBE_SIZE, Vector2i(SCALED_CUBE_SIZE));
+
+         entity->addComponent<TextureComponent>(scene->blockTexture, false, false);
+
+         entity->addComponent<SpritesheetComponent>(ORIGINAL_CUBE_SIZE, ORIGINAL_CUBE_SIZE, 1, 1, 1,
+                                                    ORIGINAL_CUBE_SIZE, ORIGINAL_CUBE_SIZE,
+                                                    Map::BlockIDCoordinates.at(entityID));
+
+         const WarpPipeData* pipe =
+             scene->getLevelData().findWarpPipe(Vector2i(coordinateX, coordinateY));
+
+         if (pipe != nullptr && std::get<3>(*pipe) != Direction::NONE) {
+            Vector2i playerCoordinates = std::get<1>(*pipe);
+            Vector2i cameraCoordinates = std::get<2>(*pipe);
+            Direction inDirection = std::get<3>(*pipe);
+            Direction outDirection = std::get<4>(*pipe);
+            bool cameraFreeze = std::get<5>(*pipe);
+            BackgroundColor color = std::get<6>(*pipe);
+            LevelType levelType = std::get<7>(*pipe);
+            Vector2i newLevel = std::get<8>(*pipe);
+
+            entity->addComponent<WarpPipeComponent>(playerCoordinates, cameraCoordinates,
+                                                    inDirection, outDirection, cameraFreeze,
+                                                    color, levelType, newLevel);
+
+            switch (inDirection) {
+               case Direction::UP:
+                  position->hitbox.x = 32;
+                  position->hitbox.w = 0;
+                  break;
+               case Direction::DOWN:
+                  position->hitbox.x = 32;
+                  position->hitbox.w = 0;
+                  break;
+               case Direction::LEFT:
+                  position->hitbox.y = 32;
+                  position->hitbox.h = 0;
+                  break;
+               case Direction::RIGHT:
+                  position->hitbox.y = 32;
+                  position->hitbox.h = 0;
+                  break;
+               default:
+                  break;
+            }
+         }
+
+         entity->addComponent<AboveForegroundComponent>();
+      } break;
+      default:
+         createAboveForegroundEntity(world, coordinateX, coordinateY, entityID);
+         break;
+   }
+}
+
+// Enemies that take up more than one tile are created from their first tile, the other IDs are
+// skipped
+bool MapSystem::isEnemyPart(int entityID) {
+   switch (entityID) {
+      case 73:
+      case 79:
+      case 83:
+      case 85:
+      case 91:
+      case 490:
+      case 492:
+      case 496:
+         return true;
+      default:
+         return false;
+   }
+}
+
+// Plain blocks are nothing but a sprite, the blocks that are handled by a case in
+// createForegroundEntities() (or skipped by it) are not
+bool MapSystem::isPlainBlock(int referenceID) {
+   switch (referenceID) {
+      case -1:
+      case 63:
+      case 101:
+      case 144:
+      case 149:
+      case 152:
+      case 192:
+      case 240:
+      case 289:
+      case 290:
+      case 339:
+      case 346:
+      case 392:
+      case 394:
+      case 609:
+      case 761:
+      case 762:
+      case 809:
+      case 810:
+      case 811:
+      case 857:
+      case 858:
+      case 859:
+         return false;
+      default:
+         return true;
+   }
+}
+
 void MapSystem::loadEntities(World* world) {
-   auto blockTexture = scene->blockTexture;
-   auto enemyTexture = scene->enemyTexture;
+   indexMysteryBoxes();
+
+   if (streamingEnabled) {
+      // Only the columns that can be seen from where the camera starts are created now, the rest
+      // are created by tick() as the camera gets to them
+      int levelWidth = scene->foregroundMap.getLevelData().getWidth();
+
+      columnStates.assign(levelWidth, ColumnState::UNLOADED);
+      columnScenery.assign(levelWidth, std::vector<Entity*>());
+      lowestLoadedColumn = levelWidth;
+
+      int startColumn = scene->getLevelData().cameraStart.x;
+
+      spawnColumns(world, startColumn - 1, startColumn + SCREEN_WIDTH / SCALED_CUBE_SIZE);
+   } else {
+      loadAllEntities(world);
+   }
+
+   // Floating text
+   for (auto floatingText : scene->getLevelData().floatingTextLocations) {
+      Entity* text(world->create());
+
+      text->addComponent<PositionComponent>(
+          std::get<0>(floatingText).convertTo<float>() * SCALED_CUBE_SIZE, Vector2i());
+
+      text->addComponent<TextComponent>(std::get<1>(floatingText), 16, true);
+
+      text->addComponent<FloatingTextComponent>();
+   }
+}
 
-   for (unsigned i = 0; i < scene->backgroundMap.getLevelData().size(); i++) {
-      for (unsigned j = 0; j < scene->backgroundMap.getLevelData()[0].size(); j++) {
-         int entityID = scene->backgroundMap.getLevelData()[i][j];
+void MapSystem::loadAllEntities(World* world) {
+   const TileGrid& backgroundData = scene->backgroundMap.getLevelData();
+
+   for (int i = 0; i < backgroundData.getHeight(); i++) {
+      for (int j = 0; j < backgroundData.getWidth(); j++) {
+         int entityID = backgroundData[i][j];
          int referenceID = getReferenceBlockID(entityID);
          switch (referenceID) {
             case -1:
@@ -2261,34 +2288,27 @@ void MapSystem::loadEntities(World* world) {
             case 391:
             case 393:
                break;
-            default: {
-               Entity* entity(world->create());
-
-               entity->addComponent<PositionComponent>(Vector2f(j, i) * SCALED_CUBE_SIZE,
-                                                       Vector2i(SCALED_CUBE_SIZE));
-
-               entity->addComponent<TextureComponent>(blockTexture, false, false);
-
-               entity->addComponent<SpritesheetComponent>(
-                   ORIGINAL_CUBE_SIZE, ORIGINAL_CUBE_SIZE, 1, 1, 1, ORIGINAL_CUBE_SIZE,
-                   ORIGINAL_CUBE_SIZE, Map::BlockIDCoordinates.at(entityID));
-
-               entity->addComponent<BackgroundComponent>();
-            } break;
+            default:
+               createBackgroundEntity(world, j, i, entityID);
+               break;
          }
       }
    }
-   for (unsigned i = 0; i < scene->undergroundMap.getLevelData().size(); i++) {
-      for (unsigned j = 0; j < scene->undergroundMap.getLevelData()[0].size(); j++) {
-         int entityID = scene->undergroundMap.getLevelData()[i][j];
+   const TileGrid& undergroundData = scene->undergroundMap.getLevelData();
+
+   for (int i = 0; i < undergroundData.getHeight(); i++) {
+      for (int j = 0; j < undergroundData.getWidth(); j++) {
+         int entityID = undergroundData[i][j];
          int referenceID = getReferenceBlockID(entityID);
 
          createForegroundEntities(world, j, i, entityID, referenceID);
       }
    }
-   for (unsigned i = 0; i < scene->foregroundMap.getLevelData().size(); i++) {
-      for (unsigned j = 0; j < scene->foregroundMap.getLevelData()[0].size(); j++) {
-         int entityID = scene->foregroundMap.getLevelData()[i][j];
+   const TileGrid& foregroundData = scene->foregroundMap.getLevelData();
+
+   for (int i = 0; i < foregroundData.getHeight(); i++) {
+      for (int j = 0; j < foregroundData.getWidth(); j++) {
+         int entityID = foregroundData[i][j];
          int referenceID = getReferenceBlockID(entityID);
 
          createForegroundEntities(world, j, i, entityID, referenceID, true);
@@ -2297,125 +2317,153 @@ void MapSystem::loadEntities(World* world) {
 
    createFireBarEntities(world);
 
-   for (unsigned i = 0; i < scene->enemiesMap.getLevelData().size(); i++) {
-      for (unsigned j = 0; j < scene->enemiesMap.getLevelData()[0].size(); j++) {
-         int entityID = scene->enemiesMap.getLevelData()[i][j];
-         int referenceID = getReferenceEnemyID(entityID);
-         switch (entityID) {
-            case -1:
-               break;
-            case 73:
-            case 79:
-            case 83:
-            case 85:
-            case 91:
-            case 490:
-            case 492:
-            case 496:
-               break;
-            default:
-               createEnemyEntities(world, j, i, entityID, referenceID);
-               break;
+   const TileGrid& enemiesData = scene->enemiesMap.getLevelData();
+
+   for (int i = 0; i < enemiesData.getHeight(); i++) {
+      for (int j = 0; j < enemiesData.getWidth(); j++) {
+         int entityID = enemiesData[i][j];
+         if (entityID != -1 && !isEnemyPart(entityID)) {
+            createEnemyEntities(world, j, i, entityID, getReferenceEnemyID(entityID));
          }
       }
    }
-   for (unsigned int i = 0; i < scene->aboveForegroundMap.getLevelData().size(); i++) {
-      for (unsigned int j = 0; j < scene->aboveForegroundMap.getLevelData()[0].size(); j++) {
-         int entityID = scene->aboveForegroundMap.getLevelData()[i][j];
+   const TileGrid& aboveForegroundData = scene->aboveForegroundMap.getLevelData();
+
+   for (int i = 0; i < aboveForegroundData.getHeight(); i++) {
+      for (int j = 0; j < aboveForegroundData.getWidth(); j++) {
+         int entityID = aboveForegroundData[i][j];
          int referenceID = getReferenceBlockID(entityID);
-         switch (referenceID) {
-            case -1:
-               break;
-            case 150:
-            case 292: {  // WARP PIPE
-               Entity* entity(world->create());
 
-               auto* position = entity->addComponent<PositionComponent>(
-                   Vector2f(j, i) * SCALED_CUBE_SIZE, Vector2i(SCALED_CUBE_SIZE));
+         createAboveForegroundEntities(world, j, i, entityID, referenceID);
+      }
+   }
+}
 
-               entity->addComponent<TextureComponent>(blockTexture, false, false);
+void MapSystem::tick(World* world) {
+   if (!streamingActive) {
+      return;
+   }
 
-               entity->addComponent<SpritesheetComponent>(
-                   ORIGINAL_CUBE_SIZE, ORIGINAL_CUBE_SIZE, 1, 1, 1, ORIGINAL_CUBE_SIZE,
-                   ORIGINAL_CUBE_SIZE, Map::BlockIDCoordinates.at(entityID));
-
-               auto pipe =
-                   getPipeCoordinate(scene->getLevelData().warpPipeLocations, Vector2i(j, i));
-
-               if (std::get<2>(pipe) != Direction::NONE) {
-                  Vector2i playerCoordinates = std::get<0>(pipe);
-                  Vector2i cameraCoordinates = std::get<1>(pipe);
-                  Direction inDirection = std::get<2>(pipe);
-                  Direction outDirection = std::get<3>(pipe);
-                  bool cameraFreeze = std::get<4>(pipe);
-                  BackgroundColor color = std::get<5>(pipe);
-                  LevelType levelType = std::get<6>(pipe);
-                  Vector2i newLevel = std::get<7>(pipe);
-
-                  entity->addComponent<WarpPipeComponent>(playerCoordinates, cameraCoordinates,
-                                                          inDirection, outDirection, cameraFreeze,
-                                                          color, levelType, newLevel);
-
-                  switch (inDirection) {
-                     case Direction::UP:
-                        position->hitbox.x = 32;
-                        position->hitbox.w = 0;
-                        break;
-                     case Direction::DOWN:
-                        position->hitbox.x = 32;
-                        position->hitbox.w = 0;
-                        break;
-                     case Direction::LEFT:
-                        position->hitbox.y = 32;
-                        position->hitbox.h = 0;
-                        break;
-                     case Direction::RIGHT:
-                        position->hitbox.y = 32;
-                        position->hitbox.h = 0;
-                        break;
-                     default:
-                        break;
-                  }
-               }
+   Camera& camera = Camera::Get();
 
-               entity->addComponent<AboveForegroundComponent>();
-            } break;
-            default: {
-               Entity* entity(world->create());
+   int leftColumn = (int)std::floor(camera.getCameraLeft() / SCALED_CUBE_SIZE);
+   int rightColumn = (int)std::floor(camera.getCameraRight() / SCALED_CUBE_SIZE);
 
-               entity->addComponent<PositionComponent>(Vector2f(j, i) * SCALED_CUBE_SIZE,
-                                                       Vector2i(SCALED_CUBE_SIZE));
+   spawnColumns(world, leftColumn - 1, rightColumn + STREAM_AHEAD_COLUMNS);
 
-               entity->addComponent<TextureComponent>(blockTexture, false, false);
+   int retireBefore =
+       (int)std::floor(camera.getCameraMinX() / SCALED_CUBE_SIZE) - RETIRE_BEHIND_COLUMNS;
 
-               entity->addComponent<SpritesheetComponent>(
-                   ORIGINAL_CUBE_SIZE, ORIGINAL_CUBE_SIZE, 1, 1, 1, ORIGINAL_CUBE_SIZE,
-                   ORIGINAL_CUBE_SIZE, Map::BlockIDCoordinates.at(entityID));
+   // Every column before lowestLoadedColumn is either unloaded or retired already
+   for (int column = lowestLoadedColumn; column < retireBefore; column++) {
+      if (columnStates[column] == ColumnState::LOADED) {
+         retireColumn(world, column);
+      }
+   }
+   lowestLoadedColumn = std::max(lowestLoadedColumn, retireBefore);
+}
 
-               entity->addComponent<AboveForegroundComponent>();
-            } break;
-         }
+void MapSystem::setStreamingActive(bool active) {
+   streamingActive = active && streamingEnabled;
+
+   // The entities in the lists are destroyed along with the rest of the level
+   if (!active) {
+      columnStates.clear();
+      columnScenery.clear();
+      lowestLoadedColumn = 0;
+   }
+}
+
+void MapSystem::spawnColumns(World* world, int firstColumn, int lastColumn) {
+   firstColumn = std::max(firstColumn, 0);
+   lastColumn = std::min(lastColumn, (int)columnStates.size() - 1);
+
+   for (int column = firstColumn; column <= lastColumn; column++) {
+      if (columnStates[column] == ColumnState::LOADED) {
+         continue;
       }
+
+      // The blocks and enemies that were created the first time are still in the world, only the
+      // plain blocks of a retired column need to be created again
+      spawnColumn(world, column, columnStates[column] == ColumnState::RETIRED);
+
+      columnStates[column] = ColumnState::LOADED;
+      lowestLoadedColumn = std::min(lowestLoadedColumn, column);
    }
+}
 
-   // Floating text
-   for (auto floatingText : scene->getLevelData().floatingTextLocations) {
-      Entity* text(world->create());
+void MapSystem::spawnColumn(World* world, int column, bool plainBlocksOnly) {
+   const TileGrid& backgroundData = scene->backgroundMap.getLevelData();
+   const TileGrid& undergroundData = scene->undergroundMap.getLevelData();
+   const TileGrid& foregroundData = scene->foregroundMap.getLevelData();
+   const TileGrid& enemiesData = scene->enemiesMap.getLevelData();
+   const TileGrid& aboveForegroundData = scene->aboveForegroundMap.getLevelData();
 
-      text->addComponent<PositionComponent>(
-          std::get<0>(floatingText).convertTo<float>() * SCALED_CUBE_SIZE, Vector2i());
+   std::vector<Entity*>& plainBlocks = columnScenery[column];
 
-      text->addComponent<TextComponent>(std::get<1>(floatingText), 16, true);
+   for (int row = 0; row < foregroundData.getHeight(); row++) {
+      int backgroundID = backgroundData.at(column, row);
+      int backgroundReferenceID = getReferenceBlockID(backgroundID);
 
-      text->addComponent<FloatingTextComponent>();
+      if (backgroundReferenceID != -1 && backgroundReferenceID != 391 &&
+          backgroundReferenceID != 393) {
+         plainBlocks.push_back(createBackgroundEntity(world, column, row, backgroundID));
+      }
+
+      int undergroundID = undergroundData.at(column, row);
+      int undergroundReferenceID = getReferenceBlockID(undergroundID);
+
+      if (isPlainBlock(undergroundReferenceID)) {
+         plainBlocks.push_back(createBlockEntity(world, column, row, undergroundID));
+      } else if (!plainBlocksOnly) {
+         createForegroundEntities(world, column, row, undergroundID, undergroundReferenceID);
+      }
+
+      int foregroundID = foregroundData[row][column];
+      int foregroundReferenceID = getReferenceBlockID(foregroundID);
+
+      if (isPlainBlock(foregroundReferenceID)) {
+         plainBlocks.push_back(createBlockEntity(world, column, row, foregroundID));
+      } else if (!plainBlocksOnly) {
+         createForegroundEntities(world, column, row, foregroundID, foregroundReferenceID, true);
+      }
+
+      int enemyID = enemiesData.at(column, row);
+
+      if (!plainBlocksOnly && enemyID != -1 && !isEnemyPart(enemyID)) {
+         createEnemyEntities(world, column, row, enemyID, getReferenceEnemyID(enemyID));
+      }
+
+      int aboveForegroundID = aboveForegroundData.at(column, row);
+      int aboveForegroundReferenceID = getReferenceBlockID(aboveForegroundID);
+
+      // Everything but the warp pipes is only drawn over the foreground
+      if (aboveForegroundReferenceID != -1 && aboveForegroundReferenceID != 150 &&
+          aboveForegroundReferenceID != 292) {
+         plainBlocks.push_back(
+             createAboveForegroundEntity(world, column, row, aboveForegroundID));
+      } else if (!plainBlocksOnly) {
+         createAboveForegroundEntities(world, column, row, aboveForegroundID,
+                                       aboveForegroundReferenceID);
+      }
    }
 
-   // Set the camera max (i don't know where to put this)
-   Camera::Get().setCameraMaxX(scene->getLevelData().cameraMax * SCALED_CUBE_SIZE);
+   if (!plainBlocksOnly) {
+      for (const FireBarData& fireBarData : scene->getLevelData().fireBarLocations) {
+         if (std::get<0>(fireBarData).x == column) {
+            createFireBarEntity(world, fireBarData);
+         }
+      }
+   }
 }
 
-void MapSystem::loadEntities() {
-   loadEntities(scene->getWorld());
+void MapSystem::retireColumn(World* world, int column) {
+   for (Entity* entity : columnScenery[column]) {
+      world->destroy(entity);
+   }
+   columnScenery[column].clear();
+
+   columnStates[column] = ColumnState::RETIRED;
 }
 
 void MapSystem::hideGameEntities(World* world) {
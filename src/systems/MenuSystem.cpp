@@ -72,7 +72,7 @@ void MenuSystem::onAddedToWorld(World* world) {
 
 void MenuSystem::tick(World* world) {
    if (levelChange) {
-      levelNumber->getComponent<TextComponent>()->destroyTexture();
+      levelNumber->getComponent<TextComponent>()->invalidate();
       levelNumber->getComponent<TextComponent>()->text =
           std::to_string(selectedLevel) + " - " + std::to_string(selectedSublevel);
 
@@ -185,7 +185,7 @@ void OptionsSystem::tick(World* world) {
 
    SDL_Scancode pressedKey = SDL_SCANCODE_UNKNOWN;
 
-#ifdef __EMSCRIPTEN__
+   // Events are polled on the main thread, so the keys pressed this frame are read from the Input
    if (Input::Get().getCurrentRawKeys().empty()) {
       return;
    }
@@ -195,24 +195,10 @@ void OptionsSystem::tick(World* world) {
          break;
       }
    }
-#else
-   SDL_Event event;
-
-   SDL_WaitEvent(&event);
-
-   if (event.type != SDL_KEYDOWN) {
-      return;
-   }
-
-   pressedKey = event.key.keysym.scancode;
-#endif
    if (pressedKey == SDL_SCANCODE_UNKNOWN) {
       return;
    }
 
-   // Updates the input since the WaitEvent would cause a delay
-   Input::Get().update(SDL_GetKeyboardState(NULL));
-
    if (pressedKey == SDL_SCANCODE_ESCAPE) {
       hideKeySelectEntities();
       currentWaitingKey = Key::NONE;
@@ -223,7 +209,7 @@ void OptionsSystem::tick(World* world) {
 
    Entity* keyText = keyEntityMap.at(currentWaitingKey);
 
-   keyText->getComponent<TextComponent>()->destroyTexture();
+   keyText->getComponent<TextComponent>()->invalidate();
    keyText->getComponent<TextComponent>()->text = getKeybindString(currentWaitingKey);
 
    hideKeySelectEntities();
@@ -275,7 +261,7 @@ void OptionsSystem::handleInput() {
 
          showKeySelectEntities();
 
-         infoTextEnter->getComponent<TextComponent>()->destroyTexture();
+         infoTextEnter->getComponent<TextComponent>()->invalidate();
          infoTextEnter->getComponent<TextComponent>()->text =
              "PRESS KEY FOR " + getKeyString(currentWaitingKey);
       } else {
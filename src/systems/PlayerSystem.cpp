@@ -1,6 +1,7 @@
 #include "systems/PlayerSystem.h"
 
 #include "AABBCollision.h"
+#include "AudioQueue.h"
 #include "Camera.h"
 #include "Constants.h"
 #include "ECS/Components.h"
@@ -116,8 +117,7 @@ Entity* PlayerSystem::createFireball(World* world) {
              entity->addComponent<DestroyDelayedComponent>(4);
              entity->remove<MovingComponent, GravityComponent, FrictionExemptComponent>();
 
-             Entity* fireballHitSound(world->create());
-             fireballHitSound->addComponent<SoundComponent>(SoundID::BLOCK_HIT);
+             AudioQueue::Get().playSound(SoundID::BLOCK_HIT);
           } else {
              world->destroy(entity);
           }
@@ -180,8 +180,7 @@ void PlayerSystem::onGameOver(World* world, bool outOfBounds) {
    scene->stopTimer();
    scene->stopMusic();
 
-   Entity* deathSound(world->create());
-   deathSound->addComponent<SoundComponent>(SoundID::DEATH);
+   AudioQueue::Get().playSound(SoundID::DEATH);
 }
 
 void PlayerSystem::setState(Animation_State newState) {
@@ -480,8 +479,7 @@ void PlayerSystem::grow(World* world, GrowType growType) {
              },
              600);
 
-         Entity* superStarMusic(world->create());
-         superStarMusic->addComponent<MusicComponent>(MusicID::SUPER_STAR);
+         AudioQueue::Get().playMusic(MusicID::SUPER_STAR);
       } break;
       case GrowType::MUSHROOM: {
          Entity* addScore(world->create());
@@ -490,8 +488,7 @@ void PlayerSystem::grow(World* world, GrowType growType) {
          Entity* floatingText(world->create());
          floatingText->addComponent<CreateFloatingTextComponent>(mario, std::to_string(1000));
 
-         Entity* powerUpSound(world->create());
-         powerUpSound->addComponent<SoundComponent>(SoundID::POWER_UP_COLLECT);
+         AudioQueue::Get().playSound(SoundID::POWER_UP_COLLECT);
 
          if (isSuperMario() || isFireMario()) {
             return;
@@ -531,8 +528,7 @@ void PlayerSystem::grow(World* world, GrowType growType) {
          Entity* floatingText(world->create());
          floatingText->addComponent<CreateFloatingTextComponent>(mario, std::to_string(1000));
 
-         Entity* powerUpSound(world->create());
-         powerUpSound->addComponent<SoundComponent>(SoundID::POWER_UP_COLLECT);
+         AudioQueue::Get().playSound(SoundID::POWER_UP_COLLECT);
 
          if (isFireMario()) {
             return;
@@ -559,8 +555,7 @@ void PlayerSystem::grow(World* world, GrowType growType) {
 void PlayerSystem::shrink(World* world) {
    mario->getComponent<PlayerComponent>()->playerState = PlayerState::SMALL_MARIO;
 
-   Entity* shrinkSound(world->create());
-   shrinkSound->addComponent<SoundComponent>(SoundID::PIPE);
+   AudioQueue::Get().playSound(SoundID::PIPE);
 
    mario->addComponent<AnimationComponent>(std::vector<int>{25, 45, 46, 25, 45, 46, 25, 45, 46}, 12,
                                            Map::PlayerIDCoordinates, false);
@@ -857,8 +852,7 @@ void PlayerSystem::updateGroundVelocity(World* world) {
       jumpHeld = true;
       move->velocity.y = -7.3;
 
-      Entity* jumpSound(world->create());
-      jumpSound->addComponent<SoundComponent>(SoundID::JUMP);
+      AudioQueue::Get().playSound(SoundID::JUMP);
    }
    if (duck && (isSuperMario() || isFireMario())) {
       currentState = DUCKING;
@@ -968,8 +962,7 @@ void PlayerSystem::updateWaterVelocity(World* world) {
       move->velocity.y = -3.53;
       jumpHeld = true;
 
-      Entity* jumpSound(world->create());
-      jumpSound->addComponent<SoundComponent>(SoundID::STOMP);
+      AudioQueue::Get().playSound(SoundID::STOMP);
 
       currentState = SWIMMING_JUMP;
 
@@ -1280,8 +1273,7 @@ void PlayerSystem::tick(World* world) {
       createFireball(world);
       launchFireball = false;
 
-      Entity* fireballSound(world->create());
-      fireballSound->addComponent<SoundComponent>(SoundID::FIREBALL);
+      AudioQueue::Get().playSound(SoundID::FIREBALL);
    }
 
    // Enemy collision
@@ -1323,8 +1315,7 @@ void PlayerSystem::tick(World* world) {
                    createBlockDebris(world, breakable);
                    world->destroy(breakable);
 
-                   Entity* breakSound(world->create());
-                   breakSound->addComponent<SoundComponent>(SoundID::BLOCK_BREAK);
+                   AudioQueue::Get().playSound(SoundID::BLOCK_BREAK);
                 },
                 1);
             return;
@@ -1334,8 +1325,7 @@ void PlayerSystem::tick(World* world) {
       if (!breakable->hasComponent<BlockBumpComponent>()) {
          breakable->addComponent<BlockBumpComponent>(std::vector<int>{-3, -3, -2, -1, 1, 2, 3, 3});
 
-         Entity* bumpSound(world->create());
-         bumpSound->addComponent<SoundComponent>(SoundID::BLOCK_HIT);
+         AudioQueue::Get().playSound(SoundID::BLOCK_HIT);
       }
       breakable->remove<BottomCollisionComponent>();
 
@@ -1385,16 +1375,14 @@ void PlayerSystem::tick(World* world) {
             Entity* coinScore(world->create());
             coinScore->addComponent<AddScoreComponent>(100, true);
 
-            Entity* coinSound(world->create());
-            coinSound->addComponent<SoundComponent>(SoundID::COIN);
+            AudioQueue::Get().playSound(SoundID::COIN);
 
             world->destroy(collectible);
          } break;
          case CollectibleType::ONE_UP: {
             grow(world, GrowType::ONEUP);
 
-            Entity* oneUpSound(world->create());
-            oneUpSound->addComponent<SoundComponent>(SoundID::ONE_UP);
+            AudioQueue::Get().playSound(SoundID::ONE_UP);
 
             world->destroy(collectible);
          } break;
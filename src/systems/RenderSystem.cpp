@@ -6,73 +6,70 @@
 #include "TextureManager.h"
 
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_ttf.h>
 
 #include <cmath>
-#include <cstring>
 #include <iostream>
 
-void RenderSystem::onAddedToWorld(World* world) {
-   normalFont = TextureManager::Get().LoadSharedFont("res/fonts/press-start-2p.ttf", 25);
-}
-
 void RenderSystem::tick(World* world) {
-   TextureManager::Get().Clear();
+   RenderSnapshot& snapshot = TextureManager::Get().BeginSnapshot();
+
+   snapshot.backgroundColor = TextureManager::Get().getBackgroundColor();
+
    // This is to render the entities in the correct order
    if (!transitionRendering) {  // Don't show the entities being loaded during a transition
       world->find<PositionComponent, TextureComponent, BackgroundComponent>([&](Entity* entity) {
          if (Camera::Get().inCameraRange(entity->getComponent<PositionComponent>())) {
-            renderEntity(entity);
+            renderEntity(snapshot, entity);
          }
       });
       world->find<PositionComponent, TextureComponent, ForegroundComponent>([&](Entity* entity) {
          if (Camera::Get().inCameraRange(entity->getComponent<PositionComponent>())) {
-            renderEntity(entity);
+            renderEntity(snapshot, entity);
          }
       });
       world->find<PositionComponent, TextureComponent, ProjectileComponent>([&](Entity* entity) {
-         renderEntity(entity);
+         renderEntity(snapshot, entity);
       });
       world->find<PositionComponent, TextureComponent, CollectibleComponent>([&](Entity* entity) {
          if (Camera::Get().inCameraRange(entity->getComponent<PositionComponent>())) {
-            renderEntity(entity);
+            renderEntity(snapshot, entity);
          }
       });
       world->find<PositionComponent, TextureComponent, EnemyComponent>([&](Entity* entity) {
          if (Camera::Get().inCameraRange(entity->getComponent<PositionComponent>())) {
-            renderEntity(entity);
+            renderEntity(snapshot, entity);
          }
       });
       world->find<PositionComponent, TextComponent, FloatingTextComponent>([&](Entity* entity) {
-         renderText(entity, entity->getComponent<TextComponent>()->followCamera);
+         renderText(snapshot, entity, entity->getComponent<TextComponent>()->followCamera);
       });
       world->find<PositionComponent, TextureComponent, PlayerComponent>([&](Entity* entity) {
-         renderEntity(entity);
+         renderEntity(snapshot, entity);
       });
       world->find<PositionComponent, TextureComponent, AboveForegroundComponent>(
           [&](Entity* entity) {
              if (Camera::Get().inCameraRange(entity->getComponent<PositionComponent>())) {
-                renderEntity(entity);
+                renderEntity(snapshot, entity);
              }
           });
       world->find<PositionComponent, TextureComponent, ParticleComponent>([&](Entity* entity) {
-         renderEntity(entity);
+         renderEntity(snapshot, entity);
       });
    }
 
    world->find<PositionComponent, TextureComponent, IconComponent>([&](Entity* entity) {
-      renderEntity(entity, false);
+      renderEntity(snapshot, entity, false);
    });
    world->find<PositionComponent, TextComponent>([&](Entity* entity) {
       if (!entity->hasComponent<FloatingTextComponent>()) {
-         renderText(entity, entity->getComponent<TextComponent>()->followCamera);
+         renderText(snapshot, entity, entity->getComponent<TextComponent>()->followCamera);
       }
    });
 
-   TextureManager::Get().Display();
+   TextureManager::Get().PublishSnapshot();
 }
 
-void RenderSystem::renderEntity(Entity* entity, bool cameraBound) {
+void RenderSystem::renderEntity(RenderSnapshot& snapshot, Entity* entity, bool cameraBound) {
    auto* position = entity->getComponent<PositionComponent>();
    auto* texture = entity->getComponent<TextureComponent>();
 
@@ -88,41 +85,40 @@ void RenderSystem::renderEntity(Entity* entity, bool cameraBound) {
    SDL_Rect destinationRect = {(int)std::round(screenPositionX), (int)std::round(screenPositionY),
                                position->scale.x, position->scale.y};
 
-   if (entity->hasComponent<SpritesheetComponent>()) {
-      auto* spritesheet = entity->getComponent<SpritesheetComponent>();
+   SDL_Rect sourceRect = (entity->hasComponent<SpritesheetComponent>())
+                             ? entity->getComponent<SpritesheetComponent>()->getSourceRect()
+                             : SDL_Rect{0, 0, position->scale.x, position->scale.y};
+
+   // Moves the source rect onto the sheet's area of the atlas page. It is clipped to the sheet
+   // first, the same way SDL clips source rects that are larger than the texture
+   if (const SDL_Rect* atlasArea = texture->getAtlasArea()) {
+      SDL_Rect sheetRect{0, 0, atlasArea->w, atlasArea->h};
+
+      if (!SDL_IntersectRect(&sourceRect, &sheetRect, &sourceRect)) {
+         return;
+      }
 
-      TextureManager::Get().Draw(texture->getTexture(), spritesheet->getSourceRect(),
-                                 destinationRect, texture->isHorizontalFlipped(),
-                                 texture->isVerticalFlipped());
-   } else {
-      TextureManager::Get().Draw(
-          texture->getTexture(), SDL_Rect{0, 0, position->scale.x, position->scale.y},
-          destinationRect, texture->isHorizontalFlipped(), texture->isVerticalFlipped());
+      sourceRect.x += atlasArea->x;
+      sourceRect.y += atlasArea->y;
    }
+
+   snapshot.sprites.push_back(SpriteDrawCommand{texture->getTexture(), sourceRect,
+                                                destinationRect, texture->isHorizontalFlipped(),
+                                                texture->isVerticalFlipped()});
 }
 
-void RenderSystem::renderText(Entity* entity, bool followCamera) {
+void RenderSystem::renderText(RenderSnapshot& snapshot, Entity* entity, bool followCamera) {
    auto* position = entity->getComponent<PositionComponent>();
    auto* textComponent = entity->getComponent<TextComponent>();
 
-   if (textComponent->texture == nullptr || textComponent->texture == NULL) {
-      SDL_Color color = {255, 255, 255};
-      SDL_Surface* textSurface =
-          TTF_RenderText_Blended(normalFont.get(), textComponent->text.c_str(), color);
-
-      SDL_Texture* texture =
-          SDL_CreateTextureFromSurface(TextureManager::Get().getRenderer(), textSurface);
-
-      textComponent->texture = texture;
-      SDL_FreeSurface(textSurface);
-
-      const char* message = textComponent->text.c_str();
-
-      int messageWidth = strlen(message) * textComponent->fontSize;
+   if (!textComponent->measured) {
+      int messageWidth = textComponent->text.length() * textComponent->fontSize;
       int messageHeight = (int)std::round(textComponent->fontSize * (23.0 / 21.0));
 
       position->scale.x = messageWidth;
       position->scale.y = messageHeight;
+
+      textComponent->measured = true;
    }
 
    float screenPositionX =
@@ -131,10 +127,12 @@ void RenderSystem::renderText(Entity* entity, bool followCamera) {
        (followCamera) ? position->position.y - Camera::Get().getCameraY() : position->position.y;
 
    if (textComponent->isVisible()) {
-      TextureManager::Get().Draw(
-          textComponent->texture,
-          SDL_Rect{(int)std::round(screenPositionX), (int)std::round(screenPositionY),
-                   position->scale.x, position->scale.y});
+      snapshot.texts.push_back(
+          TextDrawCommand{textComponent->text,
+                          SDL_Rect{(int)std::round(screenPositionX),
+                                   (int)std::round(screenPositionY), position->scale.x,
+                                   position->scale.y},
+                          snapshot.sprites.size()});
    }
 }
 
@@ -1,5 +1,6 @@
 #include "systems/ScoreSystem.h"
 
+#include "AudioQueue.h"
 #include "Constants.h"
 #include "ECS/Components.h"
 #include "Map.h"
@@ -215,7 +216,7 @@ void ScoreSystem::tick(World* world) {
    }
 
    if (changeScore) {
-      scoreEntity->getComponent<TextComponent>()->destroyTexture();
+      scoreEntity->getComponent<TextComponent>()->invalidate();
 
       std::string scoreString = std::to_string(totalScore);
       std::string finalString = std::string{};
@@ -230,7 +231,7 @@ void ScoreSystem::tick(World* world) {
    }
 
    if (changeCoin) {
-      coinsEntity->getComponent<TextComponent>()->destroyTexture();
+      coinsEntity->getComponent<TextComponent>()->invalidate();
 
       std::string coinString = std::to_string(coins);
       std::string finalString = std::string{};
@@ -243,7 +244,7 @@ void ScoreSystem::tick(World* world) {
    }
 
    if (changeTime) {
-      timerEntity->getComponent<TextComponent>()->destroyTexture();
+      timerEntity->getComponent<TextComponent>()->invalidate();
 
       std::string timeString = std::to_string(gameTime);
       std::string finalString = std::string{};
@@ -258,18 +259,18 @@ void ScoreSystem::tick(World* world) {
 }
 
 void ScoreSystem::reset() {
-   timerEntity->getComponent<TextComponent>()->destroyTexture();
+   timerEntity->getComponent<TextComponent>()->invalidate();
    gameTime = 400;
    time = 400 * MAX_FPS;
    timerEntity->getComponent<TextComponent>()->text = std::to_string(gameTime);
 
-   worldNumberEntity->getComponent<TextComponent>()->destroyTexture();
+   worldNumberEntity->getComponent<TextComponent>()->invalidate();
    worldNumberEntity->getComponent<TextComponent>()->text =
        std::to_string(scene->getLevel()) + "-" + std::to_string(scene->getSublevel());
 }
 
 void ScoreSystem::startTimer() {
-   timerEntity->getComponent<TextComponent>()->destroyTexture();
+   timerEntity->getComponent<TextComponent>()->invalidate();
    timerRunning = true;
 }
 
@@ -279,7 +280,7 @@ void ScoreSystem::stopTimer() {
 
 void ScoreSystem::decreaseLives() {
    lives--;
-   livesText->getComponent<TextComponent>()->destroyTexture();
+   livesText->getComponent<TextComponent>()->invalidate();
    livesText->getComponent<TextComponent>()->text = " x  " + std::to_string(lives);
 }
 
@@ -291,7 +292,7 @@ void ScoreSystem::scoreCountdown(World* world) {
 
    gameTime--;
 
-   timerEntity->getComponent<TextComponent>()->destroyTexture();
+   timerEntity->getComponent<TextComponent>()->invalidate();
 
    std::string timeString = std::to_string(gameTime);
    std::string finalString = std::string{};
@@ -303,8 +304,7 @@ void ScoreSystem::scoreCountdown(World* world) {
 
    timerEntity->getComponent<TextComponent>()->text = finalString;
 
-   Entity* timerTickSound(world->create());
-   timerTickSound->addComponent<SoundComponent>(SoundID::TIMER_TICK);
+   AudioQueue::Get().playSound(SoundID::TIMER_TICK);
 
    Entity* addScore(world->create());
    addScore->addComponent<AddScoreComponent>(100);
@@ -323,7 +323,7 @@ int ScoreSystem::getLives() {
 }
 
 void ScoreSystem::showTransitionEntities() {
-   worldNumberTransition->getComponent<TextComponent>()->destroyTexture();
+   worldNumberTransition->getComponent<TextComponent>()->invalidate();
    worldNumberTransition->getComponent<TextComponent>()->text =
        "WORLD " + std::to_string(scene->getLevel()) + "-" + std::to_string(scene->getSublevel());
    worldNumberTransition->getComponent<TextComponent>()->setVisible(true);
@@ -1,22 +1,33 @@
 #include "systems/SoundSystem.h"
 
-#include "ECS/Components.h"
+#include "AudioQueue.h"
 #include "SoundManager.h"
 
-void SoundSystem::tick(World* world) {
-   world->find<SoundComponent>([world](Entity* entity) {
-      auto* sound = entity->getComponent<SoundComponent>();
+void SoundSystem::onAddedToWorld(World* world) {
+   // Sounds that the last scene asked for on its final tick aren't played in the new one
+   AudioQueue::Get().clear();
+}
 
-      SoundManager::Get().playSound(sound->soundID);
+void SoundSystem::tick(World* world) {
+   AudioEvent event;
 
-      world->destroy(entity);
-   });
+   // Only the last music is played, since each one would replace the one before it
+   bool musicChanged = false;
+   MusicID music = MusicID::OVERWORLD;
 
-   world->find<MusicComponent>([world](Entity* entity) {
-      auto* music = entity->getComponent<MusicComponent>();
+   while (AudioQueue::Get().pop(event)) {
+      if (event.type == AudioEventType::SOUND) {
+         SoundManager::Get().playSound(event.sound);
+      } else {
+         musicChanged = true;
+         music = event.music;
+      }
+   }
 
-      SoundManager::Get().playMusic(music->musicID);
+   if (musicChanged) {
+      SoundManager::Get().playMusic(music);
+   }
 
-      world->destroy(entity);
-   });
+   // After the sounds were started, so a capture mixes them into the tick that played them
+   SoundManager::Get().nextTick();
 }
@@ -0,0 +1,108 @@
+#include "util/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+   close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path) {
+   close();
+
+   HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, nullptr);
+   if (file == INVALID_HANDLE_VALUE) {
+      return false;
+   }
+
+   LARGE_INTEGER fileSize;
+   if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+      CloseHandle(file);
+      return false;
+   }
+
+   HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+   if (!mapping) {
+      CloseHandle(file);
+      return false;
+   }
+
+   void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+   if (!view) {
+      CloseHandle(mapping);
+      CloseHandle(file);
+      return false;
+   }
+
+   fileHandle = file;
+   mappingHandle = mapping;
+   mappedData = static_cast<const unsigned char*>(view);
+   mappedSize = (std::size_t)fileSize.QuadPart;
+
+   return true;
+}
+
+void MappedFile::close() {
+   if (mappedData) {
+      UnmapViewOfFile(mappedData);
+      CloseHandle(mappingHandle);
+      CloseHandle(fileHandle);
+   }
+
+   mappedData = nullptr;
+   mappedSize = 0;
+   fileHandle = nullptr;
+   mappingHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path) {
+   close();
+
+   int file = ::open(path.c_str(), O_RDONLY);
+   if (file < 0) {
+      return false;
+   }
+
+   struct stat fileStatus;
+   if (fstat(file, &fileStatus) != 0 || fileStatus.st_size == 0) {
+      ::close(file);
+      return false;
+   }
+
+   void* view = mmap(nullptr, (std::size_t)fileStatus.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+   // The mapping stays valid after the file is closed
+   ::close(file);
+
+   if (view == MAP_FAILED) {
+      return false;
+   }
+
+   mappedData = static_cast<const unsigned char*>(view);
+   mappedSize = (std::size_t)fileStatus.st_size;
+
+   return true;
+}
+
+void MappedFile::close() {
+   if (mappedData) {
+      munmap(const_cast<unsigned char*>(mappedData), mappedSize);
+   }
+
+   mappedData = nullptr;
+   mappedSize = 0;
+}
+
+#endif
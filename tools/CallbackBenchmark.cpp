@@ -0,0 +1,148 @@
+#include "util/InlineFunction.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Compares std::function with InlineFunction on a copy of the Bowser bridge sequence from
+ * FlagSystem::hitAxe: a timer that takes away one bridge part every 5 ticks, a condition that is
+ * checked every tick until the bridge is gone, and the callbacks that run after it. Many bridges
+ * are collapsed at once, and they are created again for every round, so both creating and calling
+ * the functions are measured. Built and run with "make callback-benchmark".
+ * */
+
+namespace {
+
+constexpr int BRIDGE_PARTS = 13;
+constexpr int BRIDGE_DELAY = 5;
+
+struct Bridge {
+   std::vector<int> parts;
+   int collapseSounds = 0;
+   bool bowserFalling = false;
+};
+
+// The same captures as the lambdas in hitAxe: the world, the scene and a few entities
+struct Captures {
+   void* world;
+   void* scene;
+   void* player;
+   void* bowser;
+   Bridge* bridge;
+};
+
+template <template <typename> class Function>
+struct BridgeSequence {
+   Function<void()> removePart;
+   Function<bool()> bridgeGone;
+   Function<void()> bowserFall;
+
+   int time = BRIDGE_DELAY;
+   bool finished = false;
+};
+
+template <typename Signature>
+using StdFunction = std::function<Signature>;
+
+template <typename Signature>
+using Inline = InlineFunction<Signature>;
+
+template <template <typename> class Function>
+double runRounds(int bridgeCount, int rounds, long& checksum) {
+   auto startTime = std::chrono::steady_clock::now();
+
+   std::vector<Bridge> bridges(bridgeCount);
+
+   for (int round = 0; round < rounds; round++) {
+      std::vector<BridgeSequence<Function>> sequences;
+      sequences.reserve(bridgeCount);
+
+      for (Bridge& bridge : bridges) {
+         bridge.parts.assign(BRIDGE_PARTS, 1);
+         bridge.bowserFalling = false;
+
+         Captures captures{&bridges, &sequences, &bridge.parts, &bridge.collapseSounds, &bridge};
+
+         BridgeSequence<Function> sequence;
+         sequence.removePart = [captures]() {
+            captures.bridge->parts.pop_back();
+            captures.bridge->collapseSounds++;
+         };
+         sequence.bridgeGone = [captures]() -> bool {
+            return captures.bridge->parts.empty();
+         };
+         sequence.bowserFall = [captures]() {
+            captures.bridge->bowserFalling = true;
+         };
+
+         sequences.push_back(std::move(sequence));
+      }
+
+      // Ticks until every bridge has collapsed, like the CallbackSystem and CommandScheduler do
+      bool running = true;
+      while (running) {
+         running = false;
+
+         for (BridgeSequence<Function>& sequence : sequences) {
+            if (sequence.finished) {
+               continue;
+            }
+            running = true;
+
+            if (--sequence.time == 0) {
+               sequence.removePart();
+               sequence.time = BRIDGE_DELAY;
+            }
+
+            if (sequence.bridgeGone()) {
+               sequence.bowserFall();
+               sequence.finished = true;
+            }
+         }
+      }
+   }
+
+   for (const Bridge& bridge : bridges) {
+      checksum += bridge.collapseSounds + bridge.bowserFalling;
+   }
+
+   return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime)
+       .count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+   int bridgeCount = (argc > 1) ? std::max(std::stoi(argv[1]), 1) : 1000;
+   int rounds = (argc > 2) ? std::max(std::stoi(argv[2]), 1) : 200;
+
+   static_assert(sizeof(Captures) > 16, "The captures should be too large for std::function's "
+                                        "small buffer, like the ones in the game");
+
+   long stdChecksum = 0;
+   long inlineChecksum = 0;
+
+   // One round each first, so both start with warm caches
+   runRounds<StdFunction>(bridgeCount, 1, stdChecksum);
+   runRounds<Inline>(bridgeCount, 1, inlineChecksum);
+
+   double stdMilliseconds = runRounds<StdFunction>(bridgeCount, rounds, stdChecksum);
+   double inlineMilliseconds = runRounds<Inline>(bridgeCount, rounds, inlineChecksum);
+
+   std::cout << "Collapsed " << bridgeCount << " bridges " << rounds << " times" << std::endl;
+   std::cout << "std::function:  " << stdMilliseconds << " ms" << std::endl;
+   std::cout << "InlineFunction: " << inlineMilliseconds << " ms ("
+             << stdMilliseconds / inlineMilliseconds << "x)" << std::endl;
+
+   if (stdChecksum != inlineChecksum) {
+      std::cerr << "Failed to Compare: the two runs did different work" << std::endl;
+      return 1;
+   }
+
+   return 0;
+}
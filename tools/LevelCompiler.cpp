@@ -0,0 +1,60 @@
+#define SDL_MAIN_HANDLED
+#include "LevelFile.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+ * Compiles every level folder (res/data/WorldX-Y) into a WorldX-Y.level file next to its CSV files.
+ * Built and run with "make levels", the game falls back to the CSV files for levels that weren't
+ * compiled or were changed afterwards.
+ * */
+
+int main(int argc, char** argv) {
+   std::string dataDirectory = (argc > 1) ? argv[1] : "res/data";
+
+   std::vector<std::filesystem::path> levelFolders;
+
+   std::error_code error;
+   for (const auto& entry : std::filesystem::directory_iterator(dataDirectory, error)) {
+      std::string folderName = entry.path().filename().string();
+
+      if (entry.is_directory() && folderName.rfind("World", 0) == 0) {
+         levelFolders.push_back(entry.path());
+      }
+   }
+
+   if (error) {
+      std::cerr << "Failed to Read " << dataDirectory << ": " << error.message() << std::endl;
+      return 1;
+   }
+
+   std::sort(levelFolders.begin(), levelFolders.end());
+
+   int failedLevels = 0;
+   long long totalSize = 0;
+
+   for (const std::filesystem::path& folder : levelFolders) {
+      std::string mapDataPath = (folder / folder.filename()).generic_string();
+
+      int compiledSize = LevelFile::compile(mapDataPath);
+
+      if (compiledSize < 0) {
+         failedLevels++;
+         continue;
+      }
+
+      totalSize += compiledSize;
+
+      std::cout << "Compiled " << LevelFile::getCompiledPath(mapDataPath) << " (" << compiledSize
+                << " bytes)" << std::endl;
+   }
+
+   std::cout << "Compiled " << levelFolders.size() - failedLevels << " of " << levelFolders.size()
+             << " levels into " << totalSize << " bytes" << std::endl;
+
+   return (failedLevels == 0) ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#define SDL_MAIN_HANDLED
+#include "Level.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * Parses every level's .levelproperties file, first once to check them for errors, and then over
+ * and over to measure how long parsing takes. Built and run with "make benchmark".
+ * */
+
+int main(int argc, char** argv) {
+   std::string dataDirectory = (argc > 1) ? argv[1] : "res/data";
+   int iterations = (argc > 2) ? std::max(std::stoi(argv[2]), 1) : 200;
+
+   std::vector<std::string> paths;
+   std::vector<std::string> files;
+
+   std::error_code error;
+   for (const auto& entry : std::filesystem::directory_iterator(dataDirectory, error)) {
+      std::string folderName = entry.path().filename().string();
+
+      if (!entry.is_directory() || folderName.rfind("World", 0) != 0) {
+         continue;
+      }
+
+      std::string path = (entry.path() / (folderName + ".levelproperties")).generic_string();
+
+      std::ifstream propertiesFile(path);
+      if (!propertiesFile.is_open()) {
+         continue;
+      }
+
+      std::ostringstream propertiesStream;
+      propertiesStream << propertiesFile.rdbuf();
+
+      paths.push_back(path);
+      files.push_back(propertiesStream.str());
+   }
+
+   if (files.empty()) {
+      std::cerr << "Failed to find any level properties in " << dataDirectory << std::endl;
+      return 1;
+   }
+
+   std::size_t totalBytes = 0;
+   int failedFiles = 0;  // Files with errors are still parsed, the errors are only reported
+
+   for (std::size_t i = 0; i < files.size(); i++) {
+      Level level;
+      if (!level.loadLevelData(files[i], paths[i])) {
+         failedFiles++;
+      }
+      totalBytes += files[i].size();
+   }
+
+   auto startTime = std::chrono::steady_clock::now();
+
+   for (int iteration = 0; iteration < iterations; iteration++) {
+      for (const std::string& file : files) {
+         LevelData data;
+         LevelPropertiesParser(data).parse(file);
+      }
+   }
+
+   double elapsedMilliseconds =
+       std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime)
+           .count();
+   double passMilliseconds = elapsedMilliseconds / iterations;
+
+   std::cout << "Parsed " << files.size() << " files (" << totalBytes << " bytes) " << iterations
+             << " times" << std::endl;
+   std::cout << passMilliseconds << " ms per pass over every file, "
+             << passMilliseconds * 1000.0 / files.size() << " us per file" << std::endl;
+
+   if (failedFiles > 0) {
+      std::cerr << failedFiles << " file(s) had errors" << std::endl;
+   }
+
+   return 0;
+}